@@ -0,0 +1,390 @@
+/**
+ * Unified acquisition daemon
+ *
+ * Runs the MPU6050, HMC6343 and SkyTraq readers in one process. The I2C bus
+ * is opened once and both I2C sensors are driven by an I2CScheduler thread,
+ * the serial port belongs to the GPS thread. Every task samples the same
+ * CLOCK_MONOTONIC_RAW time base (TimeBase.h) and all logs of a run share one
+ * filename stamp and one clock reference, so log2csv converts them to a
+ * common wall clock:
+ *
+ *     acq_<stamp>_imu.bin, acq_<stamp>_mag.bin, acq_<stamp>_gps.bin
+ *
+ * The periodic tasks are released at absolute times counted from a common
+ * epoch, so their sample times do not drift against each other. The
+ * scheduler sleeps on CLOCK_MONOTONIC, as clock_nanosleep() cannot use the
+ * raw clock; its release and start times are converted. The compass
+ * reads are split into command and answer phases, and the IMU reads are
+ * scheduled into the 1 ms response time between them.
+ *
+ * With -c the compass sits on a bus of its own (e.g. an i2c-gpio bus) with
+ * a second scheduler thread, so the two sensors are sampled in parallel and
+ * the compass no longer has to fit around the IMU.
+ *
+ * With -r the bus threads and the GPS thread run under SCHED_FIFO on cores
+ * of their own with memory locked, the log writers stay on core 0 (see
+ * RealTime.h).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <thread>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "I2Cdev.h"
+#include "I2CScheduler.h"
+#include "MPU6050.h"
+#include "HMC6343.h"
+#include "SkyTraqSerial.h"
+#include "SkyTraqDispatcher.h"
+#include "BinaryLog.h"
+#include "SampleClock.h"
+#include "TimeBase.h"
+#include "RealTime.h"
+
+#define PI 3.14159265359
+
+#define IMU_PERIOD_NS 1000000ull
+#define MAG_PERIOD_MS 200
+
+// Wakes the GPS thread out of epoll_wait at shutdown
+int stop_fd = -1;
+
+typedef struct imu_task {
+    MPU6050 *imu;
+    BinaryLog *log;
+    bool fifo_mode;
+    SampleClock *clock;     // FIFO mode sample times
+    MPU6050Frame frames[MPU6050_FIFO_MAX_FRAMES];
+} ImuTask;
+
+// The compass job sends each data command and collects its answer one
+// response time later; the IMU has the bus in between
+static const uint8_t MAG_COMMANDS[] = { POST_TILT, POST_HEADING, POST_ACCEL, POST_MAG };
+#define MAG_COMMAND_COUNT (sizeof(MAG_COMMANDS) / sizeof(MAG_COMMANDS[0]))
+
+typedef struct mag_task {
+    HMC6343 *compass;
+    BinaryLog *log;
+} MagTask;
+
+typedef struct gps_task {
+    SkyTraqSerial serial;
+    SkyTraqDispatcher dispatcher;
+    BinaryLog log;
+    uint64_t start_time;
+    uint64_t end_time;
+    const uint8_t *payload;
+} GpsTask;
+
+void usage(const char *name) {
+    fprintf(stderr, "Usage: %s [-r] [-f] [-m ms] [-c bus] [-s device|none]\n"
+                    "  -r             real-time mode: lock memory, SCHED_FIFO sensor threads on cores of their own\n"
+                    "  -f             buffer IMU samples in the sensor FIFO and drain them in bursts\n"
+                    "  -m ms          compass period, 0 disables the compass (default %d)\n"
+                    "  -c bus         compass bus, as I2CDEV_BUS (default: the IMU's bus)\n"
+                    "  -s device      GPS serial port, \"none\" disables the GPS (default %s)\n",
+            name, MAG_PERIOD_MS, SKYTRAQ_DEFAULT_DEVICE);
+}
+
+// One IMU job: a single motion read, or a drain of the FIFO in FIFO mode
+int64_t imu_phase(void *context, const I2CJob *job) {
+    ImuTask *task = (ImuTask *) context;
+    BinaryLog *log = task->log;
+    if (task->fifo_mode) {
+        bool overflow;
+        uint16_t count = task->imu->readFIFOFrames(task->frames, MPU6050_FIFO_MAX_FRAMES, &overflow);
+        uint64_t current_time = BinaryLog::now();
+        if (overflow) {
+            log->writeGap(current_time, 0);
+            task->clock->gap(current_time);
+        }
+        // Sample times come from the fitted sensor clock, the latency runs to the drain
+        uint64_t first = task->clock->update(current_time, count);
+        for (uint16_t i = 0; i < count; i++) {
+            uint64_t sample_time = task->clock->timestamp(first + i, current_time);
+            log->write(sample_time, current_time - sample_time, &task->frames[i]);
+        }
+        return I2C_JOB_DONE;
+    }
+
+    int16_t sample[6];
+    if (job->skipped)
+        log->writeGap(TimeBase::fromMonotonic(job->release), job->skipped);
+    uint64_t start_time = BinaryLog::now();
+    task->imu->getMotion6(&sample[0], &sample[1], &sample[2], &sample[3], &sample[4], &sample[5]);
+    uint64_t current_time = BinaryLog::now();
+    log->write(start_time, current_time - start_time, sample);
+    return I2C_JOB_DONE;
+}
+
+// One compass job: even phases send a command, odd phases collect its answer
+int64_t mag_phase(void *context, const I2CJob *job) {
+    MagTask *task = (MagTask *) context;
+    HMC6343 *compass = task->compass;
+    uint8_t command = MAG_COMMANDS[job->phase / 2];
+    if (job->phase % 2 == 0) {
+        compass->requestData(command);
+        return HMC6343_RESPONSE_MS * 1000000ll;
+    }
+    compass->collectData(command);
+    if (job->phase / 2 + 1u < MAG_COMMAND_COUNT)
+        return 0;
+
+    int16_t sample[7];
+    sample[0] = compass->heading;
+    sample[1] = compass->pitch;
+    sample[2] = compass->roll;
+    sample[3] = compass->accelX;
+    sample[4] = compass->accelY;
+    sample[5] = compass->accelZ;
+    sample[6] = compass->temperature;
+    // Measurement runs from the first command to the last answer
+    uint64_t start_time = TimeBase::fromMonotonic(job->start);
+    uint64_t current_time = BinaryLog::now();
+    task->log->write(start_time, current_time - start_time, sample);
+    return I2C_JOB_DONE;
+}
+
+void log_nav_data(const SkyTraqMessage *msg, void *context) {
+    GpsTask *gps = (GpsTask *) context;
+    gps->log.write(gps->start_time, gps->end_time - gps->start_time, gps->payload);
+}
+
+void print_reply(const SkyTraqMessage *msg, void *context) {
+    skytraqPrintMessage(stdout, msg);
+}
+
+void gps_task(GpsTask *gps) {
+    int serial_fd = gps->serial.getFD();
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = serial_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, serial_fd, &ev);
+    ev.data.fd = stop_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, stop_fd, &ev);
+
+    SkyTraqFrame frame;
+    ssize_t size;
+    bool done = false;
+    struct epoll_event events[2];
+    while (!done) {
+        int n = epoll_wait(epoll_fd, events, 2, -1);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.fd == stop_fd) {
+                done = true;
+            } else if (events[i].events & EPOLLIN) {
+                while ((size = gps->serial.receive()) > 0) {
+                    while (gps->serial.next(&frame, &gps->start_time, &gps->end_time)) {
+                        gps->payload = frame.payload;
+                        gps->dispatcher.dispatch(frame.payload, frame.length);
+                    }
+                }
+                if (size < 0 && errno != EAGAIN && errno != EINTR) {
+                    perror("Serial read");
+                    done = true;
+                }
+            } else {
+                printf("Serial port closed\n");
+                done = true;
+            }
+        }
+    }
+    close(epoll_fd);
+}
+
+int main(int argc, char **argv) {
+    bool fifo_mode = false;
+    bool realtime = false;
+    int mag_period_ms = MAG_PERIOD_MS;
+    const char *device = SKYTRAQ_DEFAULT_DEVICE;
+    const char *mag_bus_name = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "rfm:c:s:")) != -1) {
+        switch (opt) {
+            case 'r': realtime = true; break;
+            case 'f': fifo_mode = true; break;
+            case 'm': mag_period_ms = atoi(optarg); break;
+            case 'c': mag_bus_name = optarg; break;
+            case 's': device = optarg; break;
+            default: usage(argv[0]); return 1;
+        }
+    }
+    bool use_mag = mag_period_ms > 0;
+    bool use_gps = strcmp(device, "none") != 0;
+
+    // Block the signals before any thread exists, so every thread inherits the
+    // mask and the main thread alone collects them with sigwait() below
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    sigaddset(&mask, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+    stop_fd = eventfd(0, EFD_CLOEXEC);
+
+    // The log writer threads inherit core 0 from here, the sensor threads
+    // move to cores of their own once started
+    if (realtime) {
+        RealTime::lockMemory();
+        RealTime::pinThread(pthread_self(), 0);
+    }
+
+    // One stamp and one clock reference for the whole log set
+    char stamp[32], filename_buffer[255];
+    time_t t = time(NULL);
+    struct tm tm = *localtime(&t);
+    sprintf(stamp, "%04d-%02d-%02dT%02d%02d%02d",
+            tm.tm_year+1900, tm.tm_mon+1, tm.tm_mday,
+            tm.tm_hour, tm.tm_min, tm.tm_sec);
+    int64_t clock_start, realtime_start;
+    TimeBase::samplePair(&clock_start, &realtime_start);
+
+    // The bus is opened once for both I2C sensors unless the compass has one
+    // of its own
+    if (!I2Cdev::initialize())
+        return 1;
+    I2CBus mag_bus;
+    I2CBus *compass_bus = I2CBus::getDefault();
+    if (use_mag && mag_bus_name) {
+        if (!mag_bus.open(mag_bus_name))
+            return 1;
+        compass_bus = &mag_bus;
+    }
+
+    MPU6050 imu;
+    BinaryLog imu_log;
+    const float accel_scaling = 2.0/32767.0;
+    const float gyro_scaling = 250.0/32767.0*PI/180.0;
+    const double imu_scale[6] = { accel_scaling, accel_scaling, accel_scaling,
+                                  gyro_scaling, gyro_scaling, gyro_scaling };
+    sprintf(filename_buffer, "acq_%s_imu.bin", stamp);
+    if (!imu_log.open(filename_buffer, BINLOG_DEVICE_MPU6050, 6, imu_scale, 0, "MPU6050 +-2g +-250dps"))
+        return 1;
+    imu_log.setTimeReference(clock_start, realtime_start);
+    if (!imu.testConnection())
+        fprintf(stderr, "MPU6050 connection test failed! something maybe wrong, continuing anyway though ...\n");
+    const MPU6050Profile &imu_profile = fifo_mode ? MPU6050_PROFILE_FIFO_1KHZ : MPU6050_PROFILE_POLLED_1KHZ;
+    if (!imu.applyProfile(imu_profile))
+        fprintf(stderr, "MPU6050 %s configuration did not verify\n", imu_profile.name);
+    imu_log.setSamplePeriod((uint32_t) (1e9 / imu.getSampleRate()));
+
+    HMC6343 compass(compass_bus);
+    BinaryLog mag_log;
+    if (use_mag) {
+        const double mag_scale[7] = { 1/10.0*PI/180.0, 1/10.0*PI/180.0, 1/10.0*PI/180.0,
+                                      1/1024.0, 1/1024.0, 1/1024.0, 1.0 };
+        sprintf(filename_buffer, "acq_%s_mag.bin", stamp);
+        if (!mag_log.open(filename_buffer, BINLOG_DEVICE_HMC6343, 7, mag_scale, 0, "HMC6343 sideways"))
+            return 1;
+        mag_log.setTimeReference(clock_start, realtime_start);
+        mag_log.setSamplePeriod((uint32_t) mag_period_ms * 1000000u);
+        // The compass runs at 10Hz when polled faster than its default 5Hz
+        const HMC6343Profile &mag_profile = mag_period_ms < 200 ? HMC6343_PROFILE_SIDEWAYS_10HZ :
+                                                                 HMC6343_PROFILE_SIDEWAYS_5HZ;
+        if (!compass.applyProfile(mag_profile))
+            printf("HMC6343 %s configuration failed\n", mag_profile.name);
+    }
+
+    GpsTask gps;
+    if (use_gps) {
+        if (!gps.serial.open(device))
+            return 1;
+        sprintf(filename_buffer, "acq_%s_gps.bin", stamp);
+        if (!gps.log.open(filename_buffer, BINLOG_DEVICE_SKYTRAQ, 0, NULL,
+                          SKYTRAQ_NAV_DATA_LAYOUT.minLength, "SkyTraq navigation data"))
+            return 1;
+        gps.log.setTimeReference(clock_start, realtime_start);
+        gps.dispatcher.setDefaultHandlers(print_reply);
+        gps.dispatcher.setHandler(SKYTRAQ_MSG_NAV_DATA, log_nav_data, &gps);
+    }
+
+    // Both I2C sensors on one bus are served by one scheduler thread. The IMU
+    // has the higher priority, so compass transactions only run where they
+    // cannot delay an IMU read. A compass on its own bus gets its own thread
+    I2CScheduler bus;
+    I2CScheduler mag_scheduler(compass_bus);
+    I2CScheduler *mag_bus_scheduler = mag_bus_name ? &mag_scheduler : &bus;
+    SampleClock imu_clock(imu_log.getHeader()->samplePeriodNs);
+    ImuTask imu_task = { &imu, &imu_log, fifo_mode, &imu_clock, {} };
+    MagTask mag_task = { &compass, &mag_log };
+    uint64_t imu_period_ns = fifo_mode ? MPU6050_FIFO_DRAIN_NS : IMU_PERIOD_NS;
+    bus.addTask("IMU", imu_phase, &imu_task, imu_period_ns, imu_period_ns, 0);
+    if (use_mag)
+        mag_bus_scheduler->addTask("Compass", mag_phase, &mag_task, (uint64_t) mag_period_ms * 1000000ull,
+                    (uint64_t) mag_period_ms * 1000000ull, 1);
+
+    // Periodic tasks start on the same whole millisecond
+    uint64_t epoch = (I2CScheduler::now() / IMU_PERIOD_NS + 1) * IMU_PERIOD_NS;
+    bus.start(epoch);
+    if (use_mag && mag_bus_name)
+        mag_scheduler.start(epoch);
+    std::thread gps_thread;
+    if (use_gps)
+        gps_thread = std::thread(gps_task, &gps);
+    if (realtime) {
+        RealTime::configureThread(bus.getThread(), "acq_i2c", REALTIME_PRIORITY_IMU, RealTime::cpuForThread(0));
+        if (use_mag && mag_bus_name)
+            RealTime::configureThread(mag_scheduler.getThread(), "acq_mag", REALTIME_PRIORITY_MAG,
+                                      RealTime::cpuForThread(2));
+        if (use_gps)
+            RealTime::configureThread(gps_thread.native_handle(), "acq_gps", REALTIME_PRIORITY_GPS,
+                                      RealTime::cpuForThread(1));
+    }
+    printf("Logging to acq_%s_*.bin\n", stamp);
+
+    // SIGUSR1 prints the bus statistics, SIGINT or SIGTERM shuts down
+    int signum;
+    while (sigwait(&mask, &signum) == 0 && signum == SIGUSR1) {
+        I2CStats::print(stdout);
+        fflush(stdout);
+    }
+    uint64_t one = 1;
+    write(stop_fd, &one, sizeof(one));
+
+    bus.stop();
+    mag_scheduler.stop();
+    if (use_gps)
+        gps_thread.join();
+    if (fifo_mode)
+        imu.endFIFOAcquisition();
+    printf("Exiting cleanly...\n");
+
+    bus.printStats(stdout);
+    if (use_mag && mag_bus_name)
+        mag_scheduler.printStats(stdout);
+    I2CStats::print(stdout);
+    imu_log.close();
+    imu_log.printStats(stdout);
+    if (fifo_mode)
+        imu_clock.printStats(stdout, "MPU6050");
+    if (use_mag) {
+        mag_log.close();
+        mag_log.printStats(stdout);
+    }
+    if (use_gps) {
+        const SkyTraqFramerStats *stats = gps.serial.getStats();
+        printf("GPS: %u frames, %u bad checksums, %u framing errors, %u bytes discarded\n",
+               stats->frames, stats->badChecksum, stats->badFraming, stats->discarded);
+        gps.log.close();
+        gps.log.printStats(stdout);
+        gps.serial.close();
+    }
+    close(stop_fd);
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * Cost per call of the clocks behind TimeBase.
+ *
+ * Usage: clock_bench
+ *
+ * Times clock_gettime() through the C library, which uses the vDSO where
+ * the kernel provides it, against the clock_gettime system call itself, for
+ * each clock the loggers read. A clock whose library call costs about as
+ * much as the system call is not served by the vDSO on this kernel (older
+ * ARM kernels did that for CLOCK_MONOTONIC_RAW) and every record timestamp
+ * pays for a kernel entry.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/auxv.h>
+#include <sys/syscall.h>
+
+#include "TimeBase.h"
+
+#define ITERATIONS 2000000
+// Slower than this fraction of the system call counts as not using the vDSO
+#define VDSO_THRESHOLD 0.5
+
+static uint64_t sink;
+
+static double library_call(clockid_t clock) {
+    struct timespec ts;
+    uint64_t start = TimeBase::now();
+    for (long i = 0; i < ITERATIONS; i++) {
+        clock_gettime(clock, &ts);
+        sink += ts.tv_nsec;
+    }
+    return (double) (TimeBase::now() - start) / ITERATIONS;
+}
+
+static double system_call(clockid_t clock) {
+    struct timespec ts;
+    uint64_t start = TimeBase::now();
+    for (long i = 0; i < ITERATIONS; i++) {
+        syscall(SYS_clock_gettime, clock, &ts);
+        sink += ts.tv_nsec;
+    }
+    return (double) (TimeBase::now() - start) / ITERATIONS;
+}
+
+static void run(clockid_t clock, const char *name) {
+    double library = library_call(clock);
+    double kernel = system_call(clock);
+    printf("%-22s %6.1f ns/call, system call %6.1f ns/call, %s\n", name, library, kernel,
+           library < kernel * VDSO_THRESHOLD ? "vDSO" : "NOT vDSO");
+}
+
+int main() {
+    if (getauxval(AT_SYSINFO_EHDR) == 0)
+        printf("No vDSO mapped into this process, every clock read is a system call\n");
+
+    run(CLOCK_MONOTONIC_RAW, "CLOCK_MONOTONIC_RAW");
+    run(CLOCK_MONOTONIC, "CLOCK_MONOTONIC");
+    run(CLOCK_REALTIME, "CLOCK_REALTIME");
+
+    int64_t clock_ns, realtime_ns;
+    uint64_t start = TimeBase::now();
+    uint32_t width = 0;
+    for (long i = 0; i < ITERATIONS / 100; i++)
+        width = TimeBase::samplePair(&clock_ns, &realtime_ns);
+    printf("%-22s %6.1f ns/call, last pair good to %u ns\n", "TimeBase::samplePair",
+           (double) (TimeBase::now() - start) / (ITERATIONS / 100), width);
+    return sink == 1;
+}
@@ -0,0 +1,127 @@
+/**
+ * Bus time hidden behind CPU work by the asynchronous I2C queue.
+ *
+ * Usage: i2c_queue_bench [bus]
+ *
+ * Reads the MPU6050 accelerometer, temperature and gyro registers and then
+ * spends WORK_NS of CPU time on the sample, the way a reader formats and
+ * logs a record. Done synchronously the two add up. Through I2CQueue the
+ * next read is submitted before working on the previous sample, so the bus
+ * thread runs it meanwhile, and the loop waits for it in epoll on the
+ * completion eventfd. The three reads are submitted as separate mergeable
+ * requests; they go out as one burst only when the bus thread finds them
+ * queued together, which it often does not, since it may take the first
+ * before the others are pushed. The queue statistics printed last give the
+ * measured number merged. The bus defaults to the simulated one.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#include "I2Cdev.h"
+#include "I2CQueue.h"
+#include "I2CStats.h"
+
+#define ITERATIONS 2000
+#define WORK_NS 300000
+#define MPU_ADDR 0x68
+#define ACCEL_XOUT_H 0x3B
+#define TEMP_OUT_H 0x41
+#define GYRO_XOUT_H 0x43
+#define PWR_MGMT_1 0x6B
+
+static uint64_t sink;
+
+// Stand-in for the per-sample work of a reader
+static void work(const uint8_t *sample) {
+    uint64_t end = I2CStats::now() + WORK_NS;
+    while (I2CStats::now() < end)
+        sink += sample[sink % 14];
+}
+
+static double synchronous(I2CBus *bus) {
+    uint8_t sample[14];
+    uint64_t start = I2CStats::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        bus->readBytes(MPU_ADDR, ACCEL_XOUT_H, sizeof(sample), sample);
+        work(sample);
+    }
+    return (double) (I2CStats::now() - start) / ITERATIONS;
+}
+
+static void prepare(I2CRequest *request, uint8_t reg, uint16_t len, uint8_t *data) {
+    memset(request, 0, sizeof(*request));
+    request->addr = MPU_ADDR;
+    request->reg = reg;
+    request->flags = I2C_REQUEST_READ | I2C_REQUEST_MERGE;
+    request->len = len;
+    request->data = data;
+}
+
+static double asynchronous(I2CQueue *queue) {
+    uint8_t samples[2][14];
+    I2CRequest requests[2][3];
+    for (int b = 0; b < 2; b++) {
+        prepare(&requests[b][0], ACCEL_XOUT_H, 6, samples[b]);
+        prepare(&requests[b][1], TEMP_OUT_H, 2, samples[b] + 6);
+        prepare(&requests[b][2], GYRO_XOUT_H, 6, samples[b] + 8);
+    }
+
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = queue->getCompletionFD();
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, ev.data.fd, &ev);
+
+    uint64_t start = I2CStats::now();
+    for (int r = 0; r < 3; r++)
+        queue->submit(&requests[0][r]);
+    for (int i = 0; i < ITERATIONS; i++) {
+        int done = 0;
+        while (done < 3) {
+            I2CRequest *completed[3];
+            if (epoll_wait(epoll_fd, &ev, 1, -1) < 0 && errno != EINTR) {
+                perror("epoll_wait");
+                return 0;
+            }
+            done += queue->reap(completed, 3 - done);
+        }
+        // Start the next read, then work on this one while it runs
+        if (i + 1 < ITERATIONS)
+            for (int r = 0; r < 3; r++)
+                queue->submit(&requests[(i + 1) % 2][r]);
+        work(samples[i % 2]);
+    }
+    double per_sample = (double) (I2CStats::now() - start) / ITERATIONS;
+    close(epoll_fd);
+    return per_sample;
+}
+
+int main(int argc, char **argv) {
+    if (!I2Cdev::initialize(argc > 1 ? argv[1] : "sim")) {
+        fprintf(stderr, "Cannot open the I2C bus\n");
+        return 1;
+    }
+    I2CBus *bus = I2CBus::getDefault();
+    if (!bus->writeByte(MPU_ADDR, PWR_MGMT_1, 0x01)) {
+        fprintf(stderr, "No MPU6050 at 0x%02X on %s\n", MPU_ADDR, bus->name());
+        return 1;
+    }
+
+    double sync_ns = synchronous(bus);
+    I2CQueue queue(bus);
+    queue.start();
+    double async_ns = asynchronous(&queue);
+    queue.stop();
+
+    printf("Work %d us per sample on %s\n", WORK_NS / 1000, bus->name());
+    printf("synchronous  %7.1f us per sample\n", sync_ns / 1000);
+    printf("I2CQueue     %7.1f us per sample, %.1f us of bus time hidden\n",
+           async_ns / 1000, (sync_ns - async_ns) / 1000);
+    queue.printStats(stdout);
+    return sink == 1;
+}
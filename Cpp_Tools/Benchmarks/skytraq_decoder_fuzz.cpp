@@ -0,0 +1,113 @@
+/**
+ * Fuzz harness for the SkyTraq framer, dispatcher and decoders.
+ *
+ * Built with -DSKYTRAQ_LIBFUZZER and -fsanitize=fuzzer, LLVMFuzzerTestOneInput
+ * is driven by libFuzzer. Otherwise a small standalone driver feeds it
+ * random and mutated inputs, which together with ASan/UBSan catches reads
+ * past a payload or a frame.
+ *
+ * Usage: skytraq_decoder_fuzz [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "SkyTraqFramer.h"
+#include "SkyTraqDispatcher.h"
+
+static void consume(const SkyTraqMessage *message, void *context) {
+    // Touch the decoded struct so the decoder output is actually used
+    if (message->id == SKYTRAQ_MSG_NAV_DATA)
+        *(uint32_t *) context += message->nav.fixMode;
+    else
+        *(uint32_t *) context += message->id;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static uint32_t sink;
+    static SkyTraqDispatcher dispatcher;
+    static SkyTraqFramer framer;
+    static bool ready = false;
+    if (!ready) {
+        dispatcher.setDefaultHandlers(consume, &sink);
+        ready = framer.begin();
+    }
+
+    // Every decoder on the raw input, exactly as long as the input. The copy
+    // lets ASan see a read past the end.
+    uint16_t length = size > 0xFFFF ? 0xFFFF : size;
+    uint8_t *payload = (uint8_t *) malloc(length ? length : 1);
+    memcpy(payload, data, length);
+    SkyTraqMessage message;
+    skytraqDecode(payload, length, &message.nav);
+    skytraqDecode(payload, length, &message.ack);
+    skytraqDecode(payload, length, &message.version);
+    skytraqDecode(payload, length, &message.crc);
+    skytraqDecode(payload, length, &message.rate);
+    skytraqDecode(payload, length, &message.datum);
+    skytraqDecode(payload, length, &message.dopMask);
+    skytraqDecode(payload, length, &message.elevationMask);
+    dispatcher.dispatch(payload, length);
+    free(payload);
+
+    // The same bytes as a serial stream
+    framer.reset();
+    SkyTraqFrame frame;
+    for (size_t pos = 0; pos < size; ) {
+        pos += framer.push(data + pos, size - pos);
+        while (framer.next(&frame))
+            dispatcher.dispatch(frame.payload, frame.length);
+    }
+    return 0;
+}
+
+#ifndef SKYTRAQ_LIBFUZZER
+// Valid frame for a message ID with a random body, so that mutations start
+// from inputs that get past the framer
+static size_t make_frame(uint8_t *buf, uint8_t id, uint16_t length) {
+    buf[0] = 0xA0;
+    buf[1] = 0xA1;
+    buf[2] = length >> 8;
+    buf[3] = length & 0xFF;
+    buf[4] = id;
+    for (uint16_t i = 1; i < length; i++)
+        buf[4 + i] = rand();
+    buf[4 + length] = SkyTraqFramer::checksum(buf + 4, length);
+    buf[5 + length] = 0x0D;
+    buf[6 + length] = 0x0A;
+    return length + SKYTRAQ_OVERHEAD;
+}
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 200000;
+    const uint8_t ids[] = { 0x80, 0x81, 0x83, 0x84, 0x86, 0xA8, 0xAE, 0xAF, 0xB0, 0x00, 0xFF };
+    uint8_t buf[4096];
+    srand(1);
+    for (long n = 0; n < iterations; n++) {
+        size_t size = 0;
+        if (n % 4 == 0) {
+            // Pure noise
+            size = rand() % 256;
+            for (size_t i = 0; i < size; i++)
+                buf[i] = rand();
+        } else {
+            // A few valid frames of random length, then random bit flips, truncation and splices
+            int frames = 1 + rand() % 4;
+            for (int f = 0; f < frames && size < sizeof(buf) - 80; f++)
+                size += make_frame(buf + size, ids[rand() % sizeof(ids)], 1 + rand() % 70);
+            int flips = rand() % 4;
+            for (int i = 0; i < flips; i++)
+                buf[rand() % size] ^= 1 << (rand() % 8);
+            if (rand() % 3 == 0)
+                size = rand() % (size + 1);
+        }
+        LLVMFuzzerTestOneInput(buf, size);
+        // Decoders on the payload of a single frame as well
+        if (size > SKYTRAQ_HEADER_SIZE)
+            LLVMFuzzerTestOneInput(buf + SKYTRAQ_HEADER_SIZE, size - SKYTRAQ_HEADER_SIZE);
+    }
+    printf("%ld iterations completed\n", iterations);
+    return 0;
+}
+#endif
@@ -0,0 +1,66 @@
+/**
+ * Cost per message of the SkyTraq dispatcher and decoders.
+ *
+ * Usage: skytraq_dispatch_bench
+ *
+ * Dispatches a mix of navigation data, ACK/NACK and an unregistered message
+ * and reports nanoseconds per call for each, so the decode cost and the
+ * skip cost of unwanted messages can be compared.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "SkyTraqDispatcher.h"
+
+#define ITERATIONS 10000000
+
+static void consume(const SkyTraqMessage *message, void *context) {
+    if (message->id == SKYTRAQ_MSG_NAV_DATA)
+        *(uint64_t *) context += message->nav.latitude;
+    else
+        *(uint64_t *) context += message->id;
+}
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void run(SkyTraqDispatcher *dispatcher, const char *name, const uint8_t *payload, uint16_t length) {
+    double start = now();
+    for (long i = 0; i < ITERATIONS; i++)
+        dispatcher->dispatch(payload, length);
+    double seconds = now() - start;
+    printf("%-24s %6.1f ns/message\n", name, seconds / ITERATIONS * 1e9);
+}
+
+int main() {
+    uint64_t sink = 0;
+    SkyTraqDispatcher dispatcher;
+    dispatcher.setDefaultHandlers(consume, &sink);
+    // Software CRC replies are unregistered here to measure the skip path
+    dispatcher.setHandler(SKYTRAQ_MSG_SOFTWARE_CRC, NULL);
+
+    uint8_t nav[59];
+    srand(1);
+    nav[0] = SKYTRAQ_MSG_NAV_DATA;
+    for (int i = 1; i < 59; i++)
+        nav[i] = rand();
+    const uint8_t ack[] = { SKYTRAQ_MSG_ACK, 0x09 };
+    const uint8_t nack[] = { SKYTRAQ_MSG_NACK, 0x09 };
+    const uint8_t version[] = { SKYTRAQ_MSG_SOFTWARE_VERSION, 1, 0, 1, 2, 3, 0, 1, 4, 5, 0, 0x0A, 0x0B, 0x0C };
+    const uint8_t skipped[] = { SKYTRAQ_MSG_SOFTWARE_CRC, 1, 0x12, 0x34 };
+
+    run(&dispatcher, "navigation data (0xA8)", nav, sizeof(nav));
+    run(&dispatcher, "ACK (0x83)", ack, sizeof(ack));
+    run(&dispatcher, "NACK (0x84)", nack, sizeof(nack));
+    run(&dispatcher, "software version (0x80)", version, sizeof(version));
+    run(&dispatcher, "unregistered (0x81)", skipped, sizeof(skipped));
+    run(&dispatcher, "truncated nav data", nav, 30);
+
+    printf("checksum %llu\n", (unsigned long long) sink);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * Throughput benchmark for the SkyTraq framer.
+ *
+ * Usage: skytraq_framer_bench [recording]
+ *
+ * The recording is a raw byte stream captured from the receiver, e.g. with
+ * `cat /dev/ttyUSB0 > gps.bin`. Without one, a synthetic stream of navigation
+ * frames is generated with payloads containing 0D 0A and A0 A1 and with
+ * occasional corrupted bytes, so that the resync paths are exercised too.
+ * The stream is fed through the ring in chunks of several sizes to mimic
+ * different serial read patterns.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "SkyTraqFramer.h"
+
+#define SYNTHETIC_SIZE (16 * 1024 * 1024)
+#define PASSES 5
+
+static uint8_t *load_recording(const char *path, uint32_t *length) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = (uint8_t *) malloc(size);
+    if (data == NULL || fread(data, 1, size, f) != (size_t) size) {
+        fprintf(stderr, "Could not read %s\n", path);
+        free(data);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    *length = size;
+    return data;
+}
+
+static uint8_t *synthesize(uint32_t *length) {
+    uint8_t *data = (uint8_t *) malloc(SYNTHETIC_SIZE);
+    uint32_t pos = 0;
+    srand(1);
+    while (pos + 66 + 8 <= SYNTHETIC_SIZE) {
+        // 59-byte navigation data message with random body
+        uint8_t *frame = data + pos;
+        frame[0] = 0xA0;
+        frame[1] = 0xA1;
+        frame[2] = 0;
+        frame[3] = 59;
+        frame[4] = 0xA8;
+        for (int i = 1; i < 59; i++)
+            frame[4 + i] = rand();
+        // Sequences that trip up CR LF or naive sync framing
+        frame[20] = 0x0D;
+        frame[21] = 0x0A;
+        frame[30] = 0xA0;
+        frame[31] = 0xA1;
+        frame[63] = SkyTraqFramer::checksum(frame + 4, 59);
+        frame[64] = 0x0D;
+        frame[65] = 0x0A;
+        if (rand() % 100 == 0)
+            frame[rand() % 66] ^= 0x5A;
+        pos += 66;
+        // Occasional line noise between frames
+        if (rand() % 50 == 0) {
+            for (int i = 0; i < 8; i++)
+                data[pos++] = rand();
+        }
+    }
+    *length = pos;
+    return data;
+}
+
+static double elapsed(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char **argv) {
+    uint32_t length;
+    uint8_t *data = argc > 1 ? load_recording(argv[1], &length) : synthesize(&length);
+    if (data == NULL)
+        return 1;
+    printf("%s: %u bytes\n", argc > 1 ? argv[1] : "synthetic stream", length);
+
+    SkyTraqFramer framer;
+    if (!framer.begin())
+        return 1;
+
+    const uint32_t chunks[] = { 64, 512, 4096 };
+    for (unsigned c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        struct timespec start, end;
+        uint64_t checksum = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int pass = 0; pass < PASSES; pass++) {
+            framer.reset();
+            SkyTraqFrame frame;
+            for (uint32_t pos = 0; pos < length; ) {
+                uint32_t n = length - pos < chunks[c] ? length - pos : chunks[c];
+                pos += framer.push(data + pos, n);
+                while (framer.next(&frame))
+                    checksum += frame.payload[0] + frame.length;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        const SkyTraqFramerStats *stats = framer.getStats();
+        double seconds = elapsed(&start, &end);
+        printf("chunk %4u: %8.1f MB/s, %10.0f frames/s  (%u frames, %u bad checksums, "
+               "%u framing errors, %u bytes discarded per pass, sum %llu)\n",
+               chunks[c], (double) length * PASSES / seconds / 1e6,
+               (double) stats->frames * PASSES / seconds,
+               stats->frames, stats->badChecksum, stats->badFraming, stats->discarded,
+               (unsigned long long) checksum);
+    }
+
+    free(data);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * Builds the MPU6050 DMP firmware image used by MPU6050::dmpLoadFirmware().
+ *
+ * The MotionApps 2.0 firmware is InvenSense code and is not shipped with this
+ * library. It is published as the dmpMemory[], dmpConfig[] and dmpUpdates[]
+ * arrays in MPU6050_6Axis_MotionApps20.h of Jeff Rowberg's Arduino i2cdevlib.
+ * This tool pulls the three arrays out of that header and writes them as one
+ * image file:
+ *
+ *     dmp_firmware MPU6050_6Axis_MotionApps20.h mpu6050_dmp20.bin
+ *
+ * Then run the readers with MPU6050_DMP_FIRMWARE=mpu6050_dmp20.bin, or pass
+ * the image to them directly.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "MPU6050.h"
+
+#define MAX_SOURCE_SIZE (1024 * 1024)
+
+// Parse the initializer of "name[...] ... = { 0x.., ... };" into data
+long extract_array(const char *source, const char *name, uint8_t *data, long capacity) {
+    char pattern[64];
+    snprintf(pattern, sizeof(pattern), "%s[", name);
+    // Skip mentions such as "// dmpMemory[]", the definition has the initializer on its line
+    const char *p = source;
+    while ((p = strstr(p, pattern)) != NULL) {
+        const char *line_end = strchr(p, '\n');
+        const char *brace = strchr(p, '{');
+        if (brace && (line_end == NULL || brace < line_end) && memchr(p, '=', brace - p))
+            break;
+        p += strlen(pattern);
+    }
+    if (p == NULL)
+        return -1;
+    p = strchr(p, '{');
+    long count = 0;
+    p++;
+    while (*p && *p != '}') {
+        if (p[0] == '/' && p[1] == '/') {
+            p = strchr(p, '\n');
+            if (p == NULL)
+                return -1;
+        } else if (p[0] == '/' && p[1] == '*') {
+            p = strstr(p + 2, "*/");
+            if (p == NULL)
+                return -1;
+            p += 2;
+        } else if (p[0] >= '0' && p[0] <= '9') {
+            char *end;
+            unsigned long value = strtoul(p, &end, 0);
+            if (value > 0xFF || count >= capacity)
+                return -1;
+            data[count++] = value;
+            p = end;
+        } else {
+            p++;
+        }
+    }
+    return *p == '}' ? count : -1;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s MPU6050_6Axis_MotionApps20.h image.bin\n", argv[0]);
+        return 1;
+    }
+
+    FILE *in = fopen(argv[1], "r");
+    if (in == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    char *source = (char *) malloc(MAX_SOURCE_SIZE + 1);
+    size_t length = fread(source, 1, MAX_SOURCE_SIZE, in);
+    source[length] = '\0';
+    fclose(in);
+
+    static uint8_t code[MPU6050_DMP_MEMORY_BANKS * MPU6050_DMP_MEMORY_BANK_SIZE];
+    static uint8_t config[MPU6050_DMP_MEMORY_BANK_SIZE];
+    static uint8_t updates[MPU6050_DMP_MEMORY_BANK_SIZE];
+    long code_size = extract_array(source, "dmpMemory", code, sizeof(code));
+    long config_size = extract_array(source, "dmpConfig", config, sizeof(config));
+    long updates_size = extract_array(source, "dmpUpdates", updates, sizeof(updates));
+    free(source);
+    if (code_size <= 0 || config_size < 0 || updates_size < 0) {
+        fprintf(stderr, "%s: could not find dmpMemory, dmpConfig and dmpUpdates\n", argv[1]);
+        return 1;
+    }
+    printf("dmpMemory %ld bytes, dmpConfig %ld bytes, dmpUpdates %ld bytes\n",
+           code_size, config_size, updates_size);
+    if (code_size != MPU6050_DMP_CODE_SIZE || config_size != MPU6050_DMP_CONFIG_SIZE ||
+        updates_size != MPU6050_DMP_UPDATES_SIZE)
+        fprintf(stderr, "Warning: MotionApps 2.0 has %d/%d/%d bytes, is this the right header?\n",
+                MPU6050_DMP_CODE_SIZE, MPU6050_DMP_CONFIG_SIZE, MPU6050_DMP_UPDATES_SIZE);
+
+    FILE *out = fopen(argv[2], "wb");
+    if (out == NULL) {
+        perror(argv[2]);
+        return 1;
+    }
+    uint8_t sizes[6] = {
+        (uint8_t) code_size, (uint8_t) (code_size >> 8),
+        (uint8_t) config_size, (uint8_t) (config_size >> 8),
+        (uint8_t) updates_size, (uint8_t) (updates_size >> 8) };
+    bool ok = fwrite(MPU6050_DMP_FIRMWARE_MAGIC, 8, 1, out) == 1 &&
+              fwrite(sizes, sizeof(sizes), 1, out) == 1 &&
+              fwrite(code, code_size, 1, out) == 1 &&
+              fwrite(config, 1, config_size, out) == (size_t) config_size &&
+              fwrite(updates, 1, updates_size, out) == (size_t) updates_size;
+    if (fclose(out) != 0 || !ok) {
+        perror(argv[2]);
+        return 1;
+    }
+    return 0;
+}
@@ -2,11 +2,11 @@
 #include <stdio.h>
 #include <signal.h>
 #include <time.h>
-#include <sys/time.h>
 
 // Libraries for I2C and the HMC6343 sensor
 #include <bcm2835.h>
 #include "HMC6343.h"
+#include "TimeBase.h"
 
 #define PI 3.14159265359
 
@@ -21,11 +21,17 @@ void getOffsets(HMC6343* compass, int16_t* xoffset, int16_t* yoffset, int16_t* z
     *xoffset = compass->readEEPROM(XOFFSET_MSB) << 8;
     *xoffset |= compass->readEEPROM(XOFFSET_LSB);
     *yoffset = compass->readEEPROM(YOFFSET_MSB) << 8;
-    *yoffset |= compass->readEEPROM(XOFFSET_LSB);
+    *yoffset |= compass->readEEPROM(YOFFSET_LSB);
     *zoffset = compass->readEEPROM(ZOFFSET_MSB) << 8;
     *zoffset |= compass->readEEPROM(ZOFFSET_LSB);
 }
 
+// Wall-clock seconds and microseconds of a raw clock time, offset is realtime - raw clock
+void printTime(FILE *f, int64_t offset, uint64_t time_ns) {
+    int64_t real = (int64_t) time_ns + offset;
+    fprintf(f, "%ld.%06ld,", (long int) (real / 1000000000ll), (long int) (real % 1000000000ll / 1000));
+}
+
 int main() {
     // Set up signal handler
     struct sigaction action;
@@ -54,8 +60,12 @@ int main() {
     // Ensure orientation is selected, options are LEVEL, SIDEWAYS, and FLATFRONT (enumerated in HMC6343 header)
     compass.setOrientation(SIDEWAYS);
 
-    // Initialize time
-    struct timeval start_time, current_time;
+    // Measure on the raw clock and print wall time from one pair, so the
+    // calibration intervals are right even if NTP steps the clock
+    uint64_t start_time, current_time;
+    int64_t clock_start, realtime_start;
+    TimeBase::samplePair(&clock_start, &realtime_start);
+    int64_t offset = realtime_start - clock_start;
 
     // Print calibration values
     int16_t xoffset, yoffset, zoffset;
@@ -68,16 +78,15 @@ int main() {
     compass.enterCalMode();
     while(!done) {
         // Read compass data
-        gettimeofday(&start_time, NULL);
+        start_time = TimeBase::now();
         compass.readTilt();
         compass.readHeading();
         compass.readAccel();
         compass.readMag();
-        gettimeofday(&current_time, NULL);
+        current_time = TimeBase::now();
         // Print start and end times of measurement
-        fprintf(f,"%ld.%06ld,%ld.%06ld,",
-            (long int) start_time.tv_sec, (long int) start_time.tv_usec, 
-            (long int) current_time.tv_sec, (long int) current_time.tv_usec);
+        printTime(f, offset, start_time);
+        printTime(f, offset, current_time);
         // Print yaw, pitch, roll in radians
         fprintf(f,"%0.6f,%0.6f,%0.6f,",
                 (float) compass.heading/10.0*PI/180.0, (float) compass.pitch/10.0*PI/180.0, (float) compass.roll/10.0*PI/180.0);
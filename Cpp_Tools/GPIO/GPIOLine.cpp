@@ -0,0 +1,116 @@
+// GPIO edge events through the Linux GPIO character device (gpio v2 uAPI).
+
+#include "GPIOLine.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+// Events fetched per read(), matches the kernel's default per-line queue
+#define GPIO_EVENT_BATCH 16
+
+GPIOLine::GPIOLine() : fd(-1), haveSeqno(false), lastSeqno(0) { }
+
+GPIOLine::~GPIOLine() {
+  release();
+}
+
+/** Request edge events for one line of a GPIO chip.
+ * @param chip Chip name ("gpiochip0") or device path ("/dev/gpiochip0")
+ * @param offset Line offset on the chip (BCM GPIO number on a Pi)
+ * @param edges GPIO_EDGE_RISING, GPIO_EDGE_FALLING or GPIO_EDGE_BOTH
+ * @param realtimeClock Timestamp with CLOCK_REALTIME instead of CLOCK_MONOTONIC
+ * @return True if the line was granted
+ */
+bool GPIOLine::request(const char *chip, uint32_t offset, uint8_t edges, bool realtimeClock) {
+  char path[64];
+  if (strchr(chip, '/'))
+    snprintf(path, sizeof(path), "%s", chip);
+  else
+    snprintf(path, sizeof(path), "/dev/%s", chip);
+
+  int chipFD = open(path, O_RDONLY | O_CLOEXEC);
+  if (chipFD < 0) {
+    fprintf(stderr, "Could not open %s: %s\n", path, strerror(errno));
+    return false;
+  }
+
+  struct gpio_v2_line_request req;
+  memset(&req, 0, sizeof(req));
+  req.offsets[0] = offset;
+  req.num_lines = 1;
+  snprintf(req.consumer, sizeof(req.consumer), "lowcost-sensors");
+  req.config.flags = GPIO_V2_LINE_FLAG_INPUT;
+  if (edges & GPIO_EDGE_RISING) req.config.flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+  if (edges & GPIO_EDGE_FALLING) req.config.flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+  if (realtimeClock) req.config.flags |= GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME;
+
+  int ret = ioctl(chipFD, GPIO_V2_GET_LINE_IOCTL, &req);
+  close(chipFD);
+  if (ret < 0) {
+    fprintf(stderr, "Could not request line %u of %s: %s\n", offset, path, strerror(errno));
+    return false;
+  }
+  attach(req.fd);
+  return true;
+}
+
+/** Use an already open event source instead of requesting a line.
+ * Ownership of fd passes to this object.
+ * @param fd Descriptor that yields struct gpio_v2_line_event records
+ */
+void GPIOLine::attach(int fd) {
+  release();
+  this->fd = fd;
+  haveSeqno = false;
+}
+
+/** Close the line, returning it to the kernel.
+ */
+void GPIOLine::release() {
+  if (fd >= 0) {
+    close(fd);
+    fd = -1;
+  }
+}
+
+/** Wait for the next edge.
+ * All queued edges are consumed and only the latest is reported, so a reader
+ * that fell behind acts once on the newest sample; event->missed tells how
+ * many edges were skipped over, including any the kernel had to drop.
+ * @param timeoutMs Maximum time to wait, -1 to wait forever
+ * @param event Container for the latest edge
+ * @return 1 if an edge was received, 0 on timeout, -1 on error (errno set,
+ *         EINTR when interrupted by a signal)
+ */
+int GPIOLine::waitEvent(int timeoutMs, GPIOEdgeEvent *event) {
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+  int ret = poll(&pfd, 1, timeoutMs);
+  if (ret <= 0)
+    return ret;
+
+  struct gpio_v2_line_event events[GPIO_EVENT_BATCH];
+  ssize_t size = read(fd, events, sizeof(events));
+  if (size < (ssize_t) sizeof(events[0])) {
+    if (size >= 0) errno = EIO;
+    return -1;
+  }
+  int count = size / sizeof(events[0]);
+  const struct gpio_v2_line_event *latest = &events[count - 1];
+
+  event->timestamp_ns = latest->timestamp_ns;
+  event->seqno = latest->line_seqno;
+  if (haveSeqno)
+    event->missed = latest->line_seqno - lastSeqno - 1;
+  else
+    event->missed = count - 1;
+  haveSeqno = true;
+  lastSeqno = latest->line_seqno;
+  return 1;
+}
@@ -0,0 +1,45 @@
+/* GPIO edge events through the Linux GPIO character device (gpio v2 uAPI).
+   Used to wake the readers on a sensor interrupt pin instead of polling.
+
+   The kernel timestamps each edge when the interrupt fires, so the event
+   time is independent of how late the reader gets scheduled. Any file
+   descriptor that yields struct gpio_v2_line_event records can stand in for
+   a real line (see attach()), e.g. a pipe fed by a test harness or a
+   gpio-sim line requested elsewhere.
+*/
+
+#ifndef _GPIOLINE_H_
+#define _GPIOLINE_H_
+
+#include <stdint.h>
+
+// Edges to report
+#define GPIO_EDGE_RISING  0x01
+#define GPIO_EDGE_FALLING 0x02
+#define GPIO_EDGE_BOTH    (GPIO_EDGE_RISING | GPIO_EDGE_FALLING)
+
+typedef struct gpio_edge_event {
+    uint64_t timestamp_ns;  // kernel timestamp of the latest edge
+    uint32_t seqno;         // per-line sequence number of the latest edge
+    uint32_t missed;        // edges since the previous event that were merged or dropped
+} GPIOEdgeEvent;
+
+class GPIOLine {
+ public:
+    GPIOLine();
+    ~GPIOLine();
+
+    bool request(const char *chip, uint32_t offset, uint8_t edges=GPIO_EDGE_RISING, bool realtimeClock=false);
+    void attach(int fd);
+    void release();
+
+    int getFD() const { return fd; }
+    int waitEvent(int timeoutMs, GPIOEdgeEvent *event);
+
+ private:
+    int fd;
+    bool haveSeqno;
+    uint32_t lastSeqno;
+};
+
+#endif /* _GPIOLINE_H_ */
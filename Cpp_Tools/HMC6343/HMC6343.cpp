@@ -17,8 +17,23 @@ Edits by Adam Werries to use the I2Cdev libraries instead (raspberry pi).
 
 #include "HMC6343.h"
 
-// Constructor - Creates sensor object, sets I2C address, and initializes sensor variables
-HMC6343::HMC6343() {
+// EEPROM locations that only change when written by the host
+// OP_MODE1 is left out because it tracks the orientation and run mode commands,
+// the axis offsets because the sensor rewrites them when calibration ends
+static const I2CRegisterRange HMC6343_CACHEABLE_EEPROM[] = {
+    { SLAVE_ADDR, SLAVE_ADDR },
+    { SW_VERSION, SW_VERSION },
+    { OP_MODE2, VARIATION_MSB },
+    { FILTER_LSB, FILTER_MSB },
+};
+
+// Constructor - Creates sensor object on the default bus
+HMC6343::HMC6343() : HMC6343(I2CBus::getDefault()) { }
+
+// Constructor - Creates sensor object on a given bus, sets I2C address, and initializes sensor variables
+HMC6343::HMC6343(I2CBus *bus) :
+    bus(bus),
+    eepromCache(HMC6343_CACHEABLE_EEPROM, sizeof(HMC6343_CACHEABLE_EEPROM) / sizeof(I2CRegisterRange)) {
     _addr = HMC6343_I2C_ADDR;
     
     heading = pitch = roll = 0;
@@ -52,6 +67,45 @@ bool HMC6343::init() {
     return ret;
 }
 
+// Bring the sensor into a configuration with as few transactions as possible, replacing
+// init() and setOrientation(). OP_MODE1 is read first and only the commands for the bits
+// that differ are sent; if none are, that read already verifies the profile. OP_MODE2
+// comes from the EEPROM cache after its first read and is only written when the rate
+// differs. Returns true if OP_MODE1 and OP_MODE2 end up as the profile asks
+bool HMC6343::applyProfile(const HMC6343Profile &profile) {
+    uint8_t opMode1;
+    if (!readOPMode1(&opMode1))
+      return false;
+    
+    // Each command is given the response time before the next one
+    uint8_t differs = (opMode1 ^ profile.opMode1) & HMC6343_OM1_PROFILE_MASK;
+    if (differs & HMC6343_OM1_CAL) {
+      sendCommand(profile.opMode1 & HMC6343_OM1_CAL ? ENTER_CAL : EXIT_CAL);
+      bcm2835_delay(HMC6343_RESPONSE_MS);
+    }
+    if (differs & ((1 << LEVEL) | (1 << SIDEWAYS) | (1 << FLATFRONT))) {
+      setOrientation(profile.opMode1 & (1 << SIDEWAYS) ? SIDEWAYS :
+                     profile.opMode1 & (1 << FLATFRONT) ? FLATFRONT : LEVEL);
+      bcm2835_delay(HMC6343_RESPONSE_MS);
+    }
+    if (differs & (HMC6343_OM1_RUN | HMC6343_OM1_STANDBY)) {
+      sendCommand(profile.opMode1 & HMC6343_OM1_RUN ? ENTER_RUN : ENTER_STANDBY);
+      bcm2835_delay(HMC6343_RESPONSE_MS);
+    }
+    
+    uint8_t opMode2 = readEEPROM(OP_MODE2);
+    if ((opMode2 ^ profile.opMode2) & HMC6343_OM2_RATE_MASK) {
+      opMode2 = (opMode2 & ~HMC6343_OM2_RATE_MASK) | (profile.opMode2 & HMC6343_OM2_RATE_MASK);
+      writeEEPROM(OP_MODE2, opMode2);
+      bcm2835_delay(HMC6343_EEPROM_RESPONSE_MS);
+    }
+    
+    if (differs && (!readOPMode1(&opMode1) ||
+                    ((opMode1 ^ profile.opMode1) & HMC6343_OM1_PROFILE_MASK)))
+      return false;
+    return ((opMode2 ^ profile.opMode2) & HMC6343_OM2_RATE_MASK) == 0;
+}
+
 // Send the HMC6343 a command to read the raw magnetometer values
 // Store these values in the integers magX, magY, and magZ
 void HMC6343::readMag() {
@@ -81,12 +135,17 @@ void HMC6343::readTilt() {
 // whose addresses are passed to the function by the above read commands
 void HMC6343::readGeneric(uint8_t command, int16_t* first, int16_t* second, int16_t* third) {
     sendCommand(command); // Send specified I2C command to HMC6343
-    bcm2835_delay(1); // Delay response time
+    bcm2835_delay(HMC6343_RESPONSE_MS); // Delay response time
     
+    readResponse(first, second, third);
+}
+
+// Collect the 6 byte response to a data command and consolidate it into three integers
+bool HMC6343::readResponse(int16_t* first, int16_t* second, int16_t* third) {
     clearRawData(); // Clear object's rawData[] array before storing new values in the array
     
     // Read 6 byte response via I2C and store them in rawData[] array
-    I2Cdev::readBytes(_addr, 6, rawData);
+    bool ok = bus->readBytes(_addr, 6, rawData) > 0;
     
     // Convert 6 bytes received into 3 integers
     *first = rawData[0] << 8; // MSB
@@ -95,11 +154,34 @@ void HMC6343::readGeneric(uint8_t command, int16_t* first, int16_t* second, int1
     *second |= rawData[3];
     *third = rawData[4] << 8;
     *third |= rawData[5];
+    return ok;
+}
+
+// First half of a split read: send one of the POST_ACCEL, POST_MAG, POST_HEADING or
+// POST_TILT commands. The bus is free for other devices until the response is ready.
+void HMC6343::requestData(uint8_t command) {
+    sendCommand(command);
+}
+
+// Second half of a split read, at least HMC6343_RESPONSE_MS after requestData()
+// Stores the response in the same members as the matching readX() function
+bool HMC6343::collectData(uint8_t command) {
+    switch (command) {
+      case POST_MAG:
+        return readResponse(&magX, &magY, &magZ);
+      case POST_ACCEL:
+        return readResponse(&accelX, &accelY, &accelZ);
+      case POST_HEADING:
+        return readResponse(&heading, &pitch, &roll);
+      case POST_TILT:
+        return readResponse(&pitch, &roll, &temperature);
+    }
+    return false;
 }
 
 // Send specified I2C command to HMC6343
 void HMC6343::sendCommand(uint8_t command) {
-    I2Cdev::writeByte(_addr, command);
+    bus->writeByte(_addr, command);
 }
 
 // Send enter standby mode I2C command to HMC6343
@@ -159,19 +241,29 @@ void HMC6343::reset() {
 // Refer to the HMC6343 datasheet for bit specifics
 uint8_t HMC6343::readOPMode1() {
     uint8_t opmode1 = 0x00;
-    sendCommand(POST_OPMODE1);
-    bcm2835_delay(1);
-    I2Cdev::readBytes(_addr, 1, &opmode1);
+    readOPMode1(&opmode1);
     return opmode1;
 }
 
+// As above, reporting whether the sensor answered
+bool HMC6343::readOPMode1(uint8_t *opmode1) {
+    sendCommand(POST_OPMODE1);
+    bcm2835_delay(HMC6343_RESPONSE_MS);
+    return bus->readBytes(_addr, 1, opmode1) > 0;
+}
+
 // Send a command to the HMC6343 to read a specified register of the EEPROM
+// Configuration-only locations are answered from the EEPROM cache after the first read,
+// which saves the 10ms response delay
 uint8_t HMC6343::readEEPROM(uint8_t reg) {
     uint8_t data = 0x00;
+    if (eepromCache.lookup(reg, &data))
+      return data;
     
-    I2Cdev::writeByte(_addr, READ_EEPROM, reg);
-    bcm2835_delay(10);
-    I2Cdev::readBytes(_addr, 1, &data);
+    bus->writeByte(_addr, READ_EEPROM, reg);
+    bcm2835_delay(HMC6343_EEPROM_RESPONSE_MS);
+    if (bus->readBytes(_addr, 1, &data))
+      eepromCache.store(reg, data);
     
     return data;
 }
@@ -179,7 +271,15 @@ uint8_t HMC6343::readEEPROM(uint8_t reg) {
 // Send a command to the HMC6343 to write a specified register of the EEPROM
 void HMC6343::writeEEPROM(uint8_t reg, uint8_t data) {
     uint8_t out[] = {reg, data};
-    I2Cdev::writeBytes(_addr, WRITE_EEPROM, 2, out);
+    if (bus->writeBytes(_addr, WRITE_EEPROM, 2, out))
+      eepromCache.store(reg, data);
+    else
+      eepromCache.invalidate(reg);
+}
+
+// Forget all cached EEPROM values, e.g. after another tool reprogrammed the sensor
+void HMC6343::invalidateEEPROMCache() {
+    eepromCache.invalidate();
 }
 
 // Clears the sensor object's rawData[] array, used before taking new measurements
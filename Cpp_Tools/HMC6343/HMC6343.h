@@ -67,15 +67,47 @@ Edits by Adam Werries to use the I2Cdev libraries instead (raspberry pi).
 #define READ_EEPROM 0xE1
 #define WRITE_EEPROM 0xF1
 
+// Time from a command to its response being ready
+#define HMC6343_RESPONSE_MS 1
+#define HMC6343_EEPROM_RESPONSE_MS 10
+
 // HMC6343 Orientations
 #define LEVEL 0     // X = forward, +Z = up (default)
 #define SIDEWAYS 1  // X = forward, +Y = up
 #define FLATFRONT 2 // Z = forward, -X = up
 
+// OP_MODE1 bits; the orientation bit of orientation n is (1 << n)
+#define HMC6343_OM1_STANDBY 0x08
+#define HMC6343_OM1_RUN 0x10
+#define HMC6343_OM1_CAL 0x40
+// The bits a profile sets, the others report filter and compass status
+#define HMC6343_OM1_PROFILE_MASK 0x5F
+
+// OP_MODE2 measurement rates
+#define HMC6343_RATE_1HZ 0x00
+#define HMC6343_RATE_5HZ 0x01  // default
+#define HMC6343_RATE_10HZ 0x02
+#define HMC6343_OM2_RATE_MASK 0x03
+
+// Startup configuration: orientation and run mode (OP_MODE1) and measurement rate (OP_MODE2)
+typedef struct hmc6343_profile {
+    const char *name;
+    uint8_t opMode1;
+    uint8_t opMode2;
+} HMC6343Profile;
+
+constexpr HMC6343Profile HMC6343_PROFILE_SIDEWAYS_5HZ = {
+    "sideways 5Hz", HMC6343_OM1_RUN | (1 << SIDEWAYS), HMC6343_RATE_5HZ };
+constexpr HMC6343Profile HMC6343_PROFILE_SIDEWAYS_10HZ = {
+    "sideways 10Hz", HMC6343_OM1_RUN | (1 << SIDEWAYS), HMC6343_RATE_10HZ };
+constexpr HMC6343Profile HMC6343_PROFILE_LEVEL_5HZ = {
+    "level 5Hz", HMC6343_OM1_RUN | (1 << LEVEL), HMC6343_RATE_5HZ };
+
 class HMC6343
 {
  public:
     HMC6343();
+    HMC6343(I2CBus *bus);
     ~HMC6343();
     
     int16_t heading, pitch, roll;
@@ -84,12 +116,19 @@ class HMC6343
     int16_t temperature;
     
     bool init();
+    bool applyProfile(const HMC6343Profile &profile);
     
     void readMag();
     void readAccel();
     void readHeading();
     void readTilt();
 
+    // Split reads for callers that do other bus work during the response time:
+    // requestData() sends a POST_* command, collectData() picks up the answer
+    // at least HMC6343_RESPONSE_MS later
+    void requestData(uint8_t command);
+    bool collectData(uint8_t command);
+
     void enterStandby();
     void exitStandby();
     
@@ -104,18 +143,23 @@ class HMC6343
     void reset();
     
     uint8_t readOPMode1();
+    bool readOPMode1(uint8_t *opmode1);
     
     uint8_t readEEPROM(uint8_t reg);
     void writeEEPROM(uint8_t reg, uint8_t data);
+    void invalidateEEPROMCache();
 
  private:
+    I2CBus *bus;
     uint8_t _addr;
     
     uint8_t rawData[6];
+    I2CRegisterCache eepromCache;
     void clearRawData();
     
     void sendCommand(uint8_t command);
     void readGeneric(uint8_t command, int16_t* first, int16_t* second, int16_t* third);
+    bool readResponse(int16_t* first, int16_t* second, int16_t* third);
 };
 
 #endif
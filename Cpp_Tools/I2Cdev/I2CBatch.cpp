@@ -0,0 +1,78 @@
+// I2Cdev library collection - Batched register reads across devices
+// Several devices' register reads as one combined transfer.
+
+#include "I2CBatch.h"
+#include "I2CStats.h"
+
+/**
+ * @param bus Bus the devices sit on, NULL for the default bus
+ */
+I2CBatch::I2CBatch(I2CBus *bus) :
+    bus(bus ? bus : I2CBus::getDefault()), count(0), status(I2C_REASON_OK), startNs(0), endNs(0) {
+}
+
+/** Forget the reads added so far.
+ */
+void I2CBatch::clear() {
+  count = 0;
+}
+
+/** Add a register read to the batch. The batch can be executed any number of
+ * times once built, e.g. once per sample period.
+ * @param devAddr I2C slave device address
+ * @param regAddr First register to read, auto-incremented by the device
+ * @param length Number of bytes to read
+ * @param data Buffer of at least length bytes, filled by every execute()
+ * @return Index of the read for getReadTime(), or -1 if the batch is full
+ */
+int I2CBatch::addRead(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data) {
+  if (count >= I2C_BATCH_MAX_READS)
+    return -1;
+  regs[count] = regAddr;
+  msgs[2 * count].addr = devAddr;
+  msgs[2 * count].flags = I2C_MSG_WRITE;
+  msgs[2 * count].len = 1;
+  msgs[2 * count].buf = &regs[count];
+  msgs[2 * count + 1].addr = devAddr;
+  msgs[2 * count + 1].flags = I2C_MSG_READ;
+  msgs[2 * count + 1].len = length;
+  msgs[2 * count + 1].buf = data;
+  return count++;
+}
+
+/** Run all reads as one transfer. A failure leaves every buffer undefined.
+ * @return Status of operation (true = success), see getStatus() for the reason
+ */
+bool I2CBatch::execute() {
+  if (count == 0)
+    return true;
+  I2CBusLock lock(bus);
+  startNs = I2CStats::now();
+  status = bus->transfer(msgs, 2 * count);
+  endNs = I2CStats::now();
+  if (status == I2C_REASON_OK) {
+    for (uint8_t i = 0; i < count; i++) {
+      I2CRegisterCache *cache = bus->getRegisterCache(msgs[2 * i].addr);
+      if (cache)
+        cache->store(regs[i], msgs[2 * i + 1].len, msgs[2 * i + 1].buf);
+    }
+  }
+  return status == I2C_REASON_OK;
+}
+
+/** Estimated time the data of a read started coming in, counted back from
+ * the end of the last execute() at the bus clock. Tighter than the transfer's
+ * start time, which includes the software overhead ahead of the first byte.
+ * @param index Read index from addRead()
+ * @return CLOCK_MONOTONIC nanoseconds
+ */
+uint64_t I2CBatch::getReadTime(uint8_t index) const {
+  if (index >= count)
+    return endNs;
+  // (Repeated) start plus address byte and 9 bits per data byte, one stop bit at the end
+  uint64_t bitsAfter = 1;
+  for (uint8_t i = 2 * index + 1; i < 2 * count; i++)
+    bitsAfter += 9 * msgs[i].len + (i > 2 * index + 1 ? 10 : 0);
+  uint64_t ns = bitsAfter * 1000000000ull / bus->getClock();
+  return endNs - ns > startNs ? endNs - ns : startNs;
+}
@@ -0,0 +1,433 @@
+// I2Cdev library collection - I2C bus instance
+
+#include "I2CBus.h"
+#include "I2CStats.h"
+#include <stdio.h>
+#include <string.h>
+
+I2CBus::I2CBus() : transport(NULL), clockHz(0), statsBus(0) {
+  memset(caches, 0, sizeof(caches));
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+  pthread_mutex_init(&mutex, &attr);
+  pthread_mutexattr_destroy(&attr);
+}
+
+I2CBus::~I2CBus() {
+  close();
+  pthread_mutex_destroy(&mutex);
+}
+
+/** The bus the static I2Cdev functions and the default device constructors use.
+ * It exists from the first call on, but is only usable once opened.
+ */
+I2CBus *I2CBus::getDefault() {
+  static I2CBus bus;
+  return &bus;
+}
+
+/** Start a transport for this bus, replacing any previously started one.
+ * @param name Bus name as accepted by I2CTransport::create()
+ * @param clockHz Bus clock, where the backend can set it
+ * @return True if the backend could be started, else the bus is left closed
+ */
+bool I2CBus::open(const char *name, uint32_t clockHz) {
+  I2CBusLock lock(this);
+  close();
+  transport = I2CTransport::create(name);
+  this->clockHz = clockHz;
+  if (!transport->begin(clockHz)) {
+    fprintf(stderr, "Could not start I2C bus %s\n", transport->name());
+    // Leave the bus closed rather than with a backend that is not running
+    delete transport;
+    transport = NULL;
+    return false;
+  }
+  statsBus = I2CStats::registerBus(transport->name());
+  return true;
+}
+
+void I2CBus::close() {
+  I2CBusLock lock(this);
+  if (transport) {
+    transport->end();
+    delete transport;
+    transport = NULL;
+  }
+}
+
+void I2CBus::lock() {
+  pthread_mutex_lock(&mutex);
+}
+
+void I2CBus::unlock() {
+  pthread_mutex_unlock(&mutex);
+}
+
+/** Execute a list of messages as one combined transaction. Every transfer
+ * goes through here to be timed and counted.
+ * @return I2C_REASON_* status from the transport
+ */
+uint8_t I2CBus::transfer(I2CMessage *msgs, uint8_t count) {
+  I2CBusLock lock(this);
+  if (!transport)
+    return I2C_REASON_ERROR_IO;
+  uint64_t start = I2CStats::now();
+  uint8_t response = transport->transfer(msgs, count);
+  I2CStats::record(statsBus, msgs, count, response, I2CStats::now() - start);
+  return response;
+}
+
+// Write followed by a repeated-start read, as one transfer
+uint8_t I2CBus::writeRead(uint8_t devAddr, uint8_t *out, uint16_t outLength, uint8_t *in, uint16_t inLength) {
+  I2CMessage msgs[2] = {
+    { devAddr, I2C_MSG_WRITE, outLength, out },
+    { devAddr, I2C_MSG_READ, inLength, in },
+  };
+  return transfer(msgs, 2);
+}
+
+uint8_t I2CBus::write(uint8_t devAddr, uint8_t *out, uint16_t length) {
+  I2CMessage msg = { devAddr, I2C_MSG_WRITE, length, out };
+  return transfer(&msg, 1);
+}
+
+uint8_t I2CBus::read(uint8_t devAddr, uint8_t *in, uint16_t length) {
+  I2CMessage msg = { devAddr, I2C_MSG_READ, length, in };
+  return transfer(&msg, 1);
+}
+
+// Read one register, answered from the shadow cache when it is known
+uint8_t I2CBus::readRegister(uint8_t devAddr, uint8_t regAddr, uint8_t *value) {
+  I2CRegisterCache *cache = caches[devAddr & 0x7F];
+  if (cache && cache->lookup(regAddr, value))
+    return I2C_REASON_OK;
+  sendBuf[0] = regAddr;
+  uint8_t response = writeRead(devAddr, sendBuf, 1, recvBuf, 1);
+  if (response == I2C_REASON_OK) {
+    *value = recvBuf[0];
+    if (cache) cache->store(regAddr, *value);
+  }
+  return response;
+}
+
+// Send sendBuf[0] (register) plus length data bytes and keep the shadow cache in step
+uint8_t I2CBus::writeRegisters(uint8_t devAddr, uint16_t length) {
+  uint8_t response = write(devAddr, sendBuf, 1+length);
+  I2CRegisterCache *cache = caches[devAddr & 0x7F];
+  if (cache) {
+    if (response == I2C_REASON_OK)
+      cache->store(sendBuf[0], length, sendBuf+1);
+    else
+      cache->invalidate(sendBuf[0], length);
+  }
+  return response;
+}
+
+/** Attach a register shadow cache to a device.
+ * From then on cacheable registers of that device are read from the cache
+ * when known, and bit writes skip the read half of read-modify-write.
+ * @param devAddr I2C slave device address
+ * @param cache Cache owned by the caller, or NULL to detach
+ */
+void I2CBus::setRegisterCache(uint8_t devAddr, I2CRegisterCache *cache) {
+  I2CBusLock lock(this);
+  caches[devAddr & 0x7F] = cache;
+}
+
+/** Get the register shadow cache attached to a device.
+ * @return Attached cache, or NULL
+ */
+I2CRegisterCache *I2CBus::getRegisterCache(uint8_t devAddr) {
+  I2CBusLock lock(this);
+  return caches[devAddr & 0x7F];
+}
+
+/** Forget all cached registers of a device, e.g. after it was reset.
+ * @param devAddr I2C slave device address
+ */
+void I2CBus::invalidateRegisterCache(uint8_t devAddr) {
+  I2CBusLock lock(this);
+  if (caches[devAddr & 0x7F])
+    caches[devAddr & 0x7F]->invalidate();
+}
+
+/** Reload all cacheable registers of a device from the bus.
+ * Each run of consecutive cacheable registers is fetched with one burst read,
+ * volatile registers in between are never touched.
+ * @param devAddr I2C slave device address
+ * @return Status of operation (true = every burst succeeded)
+ */
+bool I2CBus::resyncRegisterCache(uint8_t devAddr) {
+  I2CBusLock lock(this);
+  I2CRegisterCache *cache = caches[devAddr & 0x7F];
+  if (!cache)
+    return false;
+  cache->invalidate();
+  bool success = true;
+  for (uint16_t reg = 0; reg < 256;) {
+    if (!cache->isCacheable(reg)) {
+      reg++;
+      continue;
+    }
+    uint16_t length = 1;
+    while (reg + length < 256 && cache->isCacheable(reg + length)) length++;
+    sendBuf[0] = reg;
+    if (writeRead(devAddr, sendBuf, 1, recvBuf, length) == I2C_REASON_OK)
+      cache->store(reg, length, recvBuf);
+    else
+      success = false;
+    reg += length;
+  }
+  return success;
+}
+
+/** Read a single bit from an 8-bit device register.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register regAddr to read from
+ * @param bitNum Bit position to read (0-7)
+ * @param data Container for single bit value
+ * @return Status of read operation (true = success)
+ */
+int8_t I2CBus::readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data) {
+  I2CBusLock lock(this);
+  uint8_t b = 0;
+  uint8_t response = readRegister(devAddr, regAddr, &b);
+  *data = b & (1 << bitNum);
+  return response == I2C_REASON_OK ;
+}
+
+/** Read multiple bits from an 8-bit device register.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register regAddr to read from
+ * @param bitStart First bit position to read (0-7)
+ * @param length Number of bits to read (not more than 8)
+ * @param data Container for right-aligned value (i.e. '101' read from any bitStart position will equal 0x05)
+ * @return Status of read operation (true = success)
+ */
+int8_t I2CBus::readBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data) {
+  I2CBusLock lock(this);
+  // 01101001 read byte
+  // 76543210 bit numbers
+  //    xxx   args: bitStart=4, length=3
+  //    010   masked
+  //   -> 010 shifted
+  uint8_t b;
+  uint8_t response = readRegister(devAddr, regAddr, &b);
+  if (response == I2C_REASON_OK) {
+    uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
+    b &= mask;
+    b >>= (bitStart - length + 1);
+    *data = b;
+  }
+  return response == I2C_REASON_OK;
+}
+
+/** Read single byte from an 8-bit device register.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register regAddr to read from
+ * @param data Container for byte value read from device
+ * @return Status of read operation (true = success)
+ */
+int8_t I2CBus::readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data) {
+  I2CBusLock lock(this);
+  uint8_t b = 0;
+  uint8_t response = readRegister(devAddr, regAddr, &b);
+  data[0] = b;
+  return response == I2C_REASON_OK;
+}
+/** Read multiple bytes without specifying any address.
+ * @param devAddr I2C slave device address
+ * @param length Number of bytes to read
+ * @param data Buffer to store read data in
+ * @return I2C_TransferReturn_TypeDef http://downloads.energymicro.com/documentation/doxygen/group__I2C.html
+ */
+int8_t I2CBus::readBytes(uint8_t devAddr, uint8_t length, uint8_t *data) {
+  I2CBusLock lock(this);
+  uint8_t response = read(devAddr, data, length);
+  return response == I2C_REASON_OK;
+}
+
+/** Read multiple bytes from an 8-bit device register.
+ * @param devAddr I2C slave device address
+ * @param regAddr First register regAddr to read from
+ * @param length Number of bytes to read
+ * @param data Buffer to store read data in
+ * @return I2C_TransferReturn_TypeDef http://downloads.energymicro.com/documentation/doxygen/group__I2C.html
+ */
+int8_t I2CBus::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data) {
+  I2CBusLock lock(this);
+  I2CRegisterCache *cache = caches[devAddr & 0x7F];
+  if (cache && cache->lookup(regAddr, length, data))
+    return true;
+  return readBlock(devAddr, regAddr, length, data);
+}
+
+/** Read a large block starting at an 8-bit device register.
+ * The data is received straight into the caller's buffer in one transfer,
+ * with no staging copy and no 255-byte limit. Intended for streaming ports
+ * such as a FIFO, where the register address does not auto-increment.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register regAddr to read from
+ * @param length Number of bytes to read
+ * @param data Buffer of at least length bytes to store read data in
+ * @return Status of read operation (true = success)
+ */
+int8_t I2CBus::readBlock(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data) {
+  I2CBusLock lock(this);
+  uint8_t reg = regAddr;
+  uint8_t response = writeRead(devAddr, &reg, 1, data, length);
+  I2CRegisterCache *cache = caches[devAddr & 0x7F];
+  if (cache && response == I2C_REASON_OK)
+    cache->store(regAddr, length, data);
+  return response == I2C_REASON_OK;
+}
+
+/** write a single bit in an 8-bit device register.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register regAddr to write to
+ * @param bitNum Bit position to write (0-7)
+ * @param value New bit value to write
+ * @return Status of operation (true = success)
+ */
+bool I2CBus::writeBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data) {
+  return writeMasked(devAddr, regAddr, 1 << bitNum, (data != 0) ? 0xFF : 0);
+}
+
+/** Write multiple bits in an 8-bit device register.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register regAddr to write to
+ * @param bitStart First bit position to write (0-7)
+ * @param length Number of bits to write (not more than 8)
+ * @param data Right-aligned value to write
+ * @return Status of operation (true = success)
+ */
+bool I2CBus::writeBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t data) {
+  //      010 value to write
+  // 76543210 bit numbers
+  //    xxx   args: bitStart=4, length=3
+  // 00011100 mask byte
+  // 10101111 original value (sample)
+  // 10100011 original & ~mask
+  // 10101011 masked | value
+  uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
+  return writeMasked(devAddr, regAddr, mask, data << (bitStart - length + 1));
+}
+
+/** Write the bits of a mask in an 8-bit device register, leaving the others.
+ * One read-modify-write for any number of fields of the register, with the
+ * read skipped when the shadow cache knows the register or the mask covers
+ * all of it.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register regAddr to write to
+ * @param mask Bits to write
+ * @param data New values of the bits in mask, in place; other bits are ignored
+ * @return Status of operation (true = success)
+ */
+bool I2CBus::writeMasked(uint8_t devAddr, uint8_t regAddr, uint8_t mask, uint8_t data) {
+  I2CBusLock lock(this);
+  uint8_t b = 0;
+  uint8_t response = I2C_REASON_OK;
+  //first reading registery value (skipped when the shadow cache knows it)
+  if (mask != 0xFF)
+    response = readRegister(devAddr, regAddr, &b);
+  if ( response == I2C_REASON_OK ) {
+    b = (b & ~mask) | (data & mask);
+    sendBuf[0] = regAddr;
+    sendBuf[1] = b ;
+    response = writeRegisters(devAddr, 1);
+  }
+  return response == I2C_REASON_OK;
+}
+
+/** Write single byte, no specified address.
+ * @param devAddr I2C slave device address
+ * @param data New byte value to write
+ * @return Status of operation (true = success)
+ */
+bool I2CBus::writeByte(uint8_t devAddr, uint8_t data) {
+  I2CBusLock lock(this);
+  sendBuf[0] = data;
+  uint8_t response = write(devAddr, sendBuf, 1);
+  return response == I2C_REASON_OK ;
+}
+
+/** Write single byte to an 8-bit device register.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register address to write to
+ * @param data New byte value to write
+ * @return Status of operation (true = success)
+ */
+bool I2CBus::writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data) {
+  I2CBusLock lock(this);
+  sendBuf[0] = regAddr;
+  sendBuf[1] = data;
+  uint8_t response = writeRegisters(devAddr, 1);
+  return response == I2C_REASON_OK ;
+}
+
+/** Read single word from a 16-bit device register.
+ * @param devAddr I2C slave device address
+ * @param regAddr Register regAddr to read from
+ * @param data Container for word value read from device
+ * @return Status of read operation (true = success)
+ */
+int8_t I2CBus::readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data) {
+  I2CBusLock lock(this);
+  sendBuf[0] = regAddr;
+  uint8_t response = writeRead(devAddr, sendBuf, 1, recvBuf, 2 );
+  data[0] = (recvBuf[0] << 8) | recvBuf[1] ;
+  return  response == I2C_REASON_OK ;
+}
+
+/** Read multiple words from a 16-bit device register.
+ * @param devAddr I2C slave device address
+ * @param regAddr First register regAddr to read from
+ * @param length Number of words to read
+ * @param data Buffer to store read data in
+ * @return Number of words read (-1 indicates failure)
+ */
+int8_t I2CBus::readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data) {
+  I2CBusLock lock(this);
+  sendBuf[0] = regAddr;
+  uint8_t response = writeRead(devAddr, sendBuf, 1, recvBuf, length*2 );
+  uint8_t i;
+  for (i = 0; i < length; i++) {
+    data[i] = (recvBuf[i*2] << 8) | recvBuf[i*2+1] ;
+  }
+  return  response == I2C_REASON_OK ;
+}
+
+bool I2CBus::writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data) {
+  I2CBusLock lock(this);
+  sendBuf[0] = regAddr;
+  sendBuf[1] = (uint8_t) (data >> 8); //MSByte
+  sendBuf[2] = (uint8_t) (data >> 0); //LSByte
+  uint8_t response = writeRegisters(devAddr, 2);
+  return response == I2C_REASON_OK ;
+}
+
+bool I2CBus::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data) {
+  I2CBusLock lock(this);
+  sendBuf[0] = regAddr;
+  uint8_t i;
+  for (i = 0; i < length; i++) {
+    sendBuf[i+1] = data[i] ;
+  }
+  uint8_t response = writeRegisters(devAddr, length);
+  return response == I2C_REASON_OK ;
+}
+
+bool I2CBus::writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data) {
+  I2CBusLock lock(this);
+  sendBuf[0] = regAddr;
+  uint8_t i;
+  for (i = 0; i < length; i++) {
+    sendBuf[1+2*i] = (uint8_t) (data[i] >> 8); //MSByte
+    sendBuf[2+2*i] = (uint8_t) (data[i] >> 0); //LSByte
+  }
+  uint8_t response = writeRegisters(devAddr, 2*length);
+  return response == I2C_REASON_OK ;
+}
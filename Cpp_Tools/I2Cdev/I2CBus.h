@@ -0,0 +1,103 @@
+/* I2Cdev library collection - I2C bus instance
+   Everything that belongs to one physical bus: its transport, clock rate,
+   transfer buffers, the register shadow caches of the devices on it and a
+   lock. Device drivers are given the bus they sit on, so sensors on
+   separate buses (e.g. i2c-1 and an i2c-gpio bus) can be sampled in
+   parallel from separate threads without ever waiting for each other.
+
+   Every operation takes the bus lock itself, so threads sharing a bus can
+   no longer corrupt each other's buffers or interleave a read-modify-write.
+   The lock is recursive: I2CBusLock holds it around a sequence of
+   operations that has to stay together, such as a command and its answer.
+   It inherits priority, so a real-time thread waiting for the bus is never
+   held up by threads of middle priority preempting the lock holder.
+
+   The static I2Cdev functions work on the default bus, which
+   I2Cdev::initialize() opens from the I2CDEV_BUS environment variable.
+*/
+
+#ifndef _I2CBUS_H_
+#define _I2CBUS_H_
+
+#include <stdint.h>
+#include <pthread.h>
+#include "I2CTransport.h"
+#include "I2CRegisterCache.h"
+
+#define I2C_DEFAULT_CLOCK_HZ 400000
+
+class I2CBus {
+ public:
+    I2CBus();
+    ~I2CBus();
+
+    bool open(const char *name, uint32_t clockHz = I2C_DEFAULT_CLOCK_HZ);
+    void close();
+    bool isOpen() const { return transport != NULL; }
+    const char *name() const { return transport ? transport->name() : "closed"; }
+    uint32_t getClock() const { return clockHz; }
+    I2CTransport *getTransport() { return transport; }
+
+    void lock();
+    void unlock();
+
+    uint8_t transfer(I2CMessage *msgs, uint8_t count);
+
+    void setRegisterCache(uint8_t devAddr, I2CRegisterCache *cache);
+    I2CRegisterCache *getRegisterCache(uint8_t devAddr);
+    void invalidateRegisterCache(uint8_t devAddr);
+    bool resyncRegisterCache(uint8_t devAddr);
+
+    int8_t readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data);
+    int8_t readBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data);
+    int8_t readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data);
+    int8_t readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data);
+    int8_t readBytes(uint8_t devAddr, uint8_t length, uint8_t *data);
+    int8_t readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
+    int8_t readBlock(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data);
+    int8_t readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data);
+
+    bool writeBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data);
+    bool writeBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t data);
+    bool writeMasked(uint8_t devAddr, uint8_t regAddr, uint8_t mask, uint8_t data);
+    bool writeByte(uint8_t devAddr, uint8_t data);
+    bool writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data);
+    bool writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data);
+    bool writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
+    bool writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data);
+
+    static I2CBus *getDefault();
+
+ private:
+    I2CTransport *transport;
+    uint32_t clockHz;
+    uint8_t statsBus;                   // I2CStats bus number
+    pthread_mutex_t mutex;
+    uint8_t sendBuf[256];
+    uint8_t recvBuf[256];
+    I2CRegisterCache *caches[128];      // indexed by 7-bit slave address
+
+    // Not copyable: the caches and the lock belong to one bus
+    I2CBus(const I2CBus &);
+    I2CBus &operator=(const I2CBus &);
+
+    uint8_t writeRead(uint8_t devAddr, uint8_t *out, uint16_t outLength, uint8_t *in, uint16_t inLength);
+    uint8_t write(uint8_t devAddr, uint8_t *out, uint16_t length);
+    uint8_t read(uint8_t devAddr, uint8_t *in, uint16_t length);
+    uint8_t readRegister(uint8_t devAddr, uint8_t regAddr, uint8_t *value);
+    uint8_t writeRegisters(uint8_t devAddr, uint16_t length);
+};
+
+/** Holds a bus lock for the lifetime of the object, to keep a sequence of
+ * operations on one device together.
+ */
+class I2CBusLock {
+ public:
+    I2CBusLock(I2CBus *bus = I2CBus::getDefault()) : bus(bus) { bus->lock(); }
+    ~I2CBusLock() { bus->unlock(); }
+
+ private:
+    I2CBus *bus;
+};
+
+#endif /* _I2CBUS_H_ */
@@ -0,0 +1,302 @@
+// I2Cdev library collection - Asynchronous bus queue
+// Lock-free request submission, a bus thread that coalesces and executes
+// the requests in order, and completion by callback or eventfd.
+
+#include "I2CQueue.h"
+#include "I2CStats.h"
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// Requests the bus thread takes from the queue at a time, the window merging looks at
+#define I2C_QUEUE_BATCH 32
+
+I2CRequestRing::I2CRequestRing() : enqueuePos(0), dequeuePos(0) {
+  for (uint32_t i = 0; i < I2C_QUEUE_CAPACITY; i++) {
+    cells[i].sequence.store(i, std::memory_order_relaxed);
+    cells[i].request = NULL;
+  }
+}
+
+/** Append a request. Safe from any number of threads.
+ * @return False if the ring is full
+ */
+bool I2CRequestRing::push(I2CRequest *request) {
+  uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+  Cell *cell;
+  for (;;) {
+    cell = &cells[pos & (I2C_QUEUE_CAPACITY - 1)];
+    int32_t diff = (int32_t) (cell->sequence.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      return false;     // the slot still holds a request a lap behind
+    } else {
+      pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+  cell->request = request;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+/** Take the oldest request. Safe from any number of threads.
+ * @return Request, or NULL if the ring is empty
+ */
+I2CRequest *I2CRequestRing::pop() {
+  uint32_t pos = dequeuePos.load(std::memory_order_relaxed);
+  Cell *cell;
+  for (;;) {
+    cell = &cells[pos & (I2C_QUEUE_CAPACITY - 1)];
+    int32_t diff = (int32_t) (cell->sequence.load(std::memory_order_acquire) - (pos + 1));
+    if (diff == 0) {
+      if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    } else if (diff < 0) {
+      return NULL;      // nothing published in this slot yet
+    } else {
+      pos = dequeuePos.load(std::memory_order_relaxed);
+    }
+  }
+  I2CRequest *request = cell->request;
+  cell->sequence.store(pos + I2C_QUEUE_CAPACITY, std::memory_order_release);
+  return request;
+}
+
+/**
+ * @param bus Bus the requests run on, NULL for the default bus
+ */
+I2CQueue::I2CQueue(I2CBus *bus) :
+    bus(bus ? bus : I2CBus::getDefault()), pending(0), idle(false), stopping(false),
+    requests(0), transfers(0), failures(0), maxBatch(0) {
+  wakeFd = eventfd(0, EFD_CLOEXEC);
+  completionFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+}
+
+I2CQueue::~I2CQueue() {
+  stop();
+  if (wakeFd >= 0) close(wakeFd);
+  if (completionFd >= 0) close(completionFd);
+}
+
+/** Start the bus thread. Requests submitted before are run straight away.
+ * @return False if the eventfds could not be created or it is already running
+ */
+bool I2CQueue::start() {
+  if (wakeFd < 0 || completionFd < 0 || thread.joinable())
+    return false;
+  stopping.store(false);
+  thread = std::thread(&I2CQueue::run, this);
+  return true;
+}
+
+/** Stop once every request submitted so far has been run.
+ */
+void I2CQueue::stop() {
+  if (!thread.joinable())
+    return;
+  stopping.store(true);
+  uint64_t one = 1;
+  if (write(wakeFd, &one, sizeof(one)) < 0)
+    perror("I2CQueue wake");
+  thread.join();
+}
+
+/** Queue a request. Never blocks; safe from any thread, including from a
+ * completion callback.
+ * @param request Filled in by the caller and left alone until it completes
+ * @return False if I2C_QUEUE_CAPACITY requests are outstanding or the request
+ *         is malformed (a register write longer than I2C_QUEUE_MERGE_MAX)
+ */
+bool I2CQueue::submit(I2CRequest *request) {
+  if (!(request->flags & (I2C_REQUEST_READ | I2C_REQUEST_BARE)) && request->len > I2C_QUEUE_MERGE_MAX)
+    return false;
+  // Reserve room in the completion ring too, so the bus thread can never find it full
+  if (pending.fetch_add(1) >= I2C_QUEUE_CAPACITY) {
+    pending.fetch_sub(1);
+    return false;
+  }
+  request->status = I2C_REASON_OK;
+  request->startNs = request->endNs = 0;
+  if (!submitted.push(request)) {
+    pending.fetch_sub(1);
+    return false;
+  }
+  // Pairs with the fence in run(): the push and the idle load here, and the
+  // idle store and the last pop there, are each kept in order, so either the
+  // bus thread finds this request or we see it going to sleep and wake it
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (idle.load(std::memory_order_relaxed)) {
+    uint64_t one = 1;
+    if (write(wakeFd, &one, sizeof(one)) < 0)
+      perror("I2CQueue wake");
+  }
+  return true;
+}
+
+/** Collect requests completed without a callback. Call when the completion
+ * eventfd is readable; it is cleared here.
+ * @param requests Array for the completed requests, in completion order
+ * @param max Size of the array
+ * @return Number of requests returned, 0 if none are waiting
+ */
+uint32_t I2CQueue::reap(I2CRequest **requests, uint32_t max) {
+  uint64_t count;
+  if (read(completionFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+    perror("I2CQueue completion");
+  uint32_t n = 0;
+  while (n < max && (requests[n] = completed.pop()) != NULL)
+    n++;
+  if (n > 0)
+    pending.fetch_sub(n);
+  // Leave the eventfd readable for whatever did not fit
+  if (n == max && max > 0) {
+    uint64_t one = 1;
+    if (write(completionFd, &one, sizeof(one)) < 0)
+      perror("I2CQueue completion");
+  }
+  return n;
+}
+
+void I2CQueue::complete(I2CRequest *request) {
+  if (request->status != I2C_REASON_OK)
+    failures.fetch_add(1, std::memory_order_relaxed);
+  if (request->callback) {
+    // Release the slot first, the callback may well submit the next request
+    pending.fetch_sub(1);
+    request->callback(request, request->context);
+  } else {
+    completed.push(request);
+  }
+}
+
+// Whether next can be run in one burst with the group ending with last
+static bool mergeable(const I2CRequest *last, const I2CRequest *next, uint16_t groupLength) {
+  return (last->flags & I2C_REQUEST_MERGE) && (next->flags & I2C_REQUEST_MERGE) &&
+         !(next->flags & I2C_REQUEST_BARE) && !(last->flags & I2C_REQUEST_BARE) &&
+         (next->flags & I2C_REQUEST_READ) == (last->flags & I2C_REQUEST_READ) &&
+         next->addr == last->addr && next->reg == (uint8_t) (last->reg + last->len) &&
+         next->reg > last->reg && groupLength + next->len <= I2C_QUEUE_MERGE_MAX;
+}
+
+/** Run the requests at the start of a batch that can go as one transfer.
+ * @return Number of requests run
+ */
+uint32_t I2CQueue::execute(I2CRequest **batch, uint32_t count) {
+  I2CRequest *first = batch[0];
+  uint32_t n = 1;
+  uint16_t length = first->len;
+  while (n < count && mergeable(batch[n - 1], batch[n], length))
+    length += batch[n++]->len;
+
+  bool reading = first->flags & I2C_REQUEST_READ;
+  // Held through the cache update, so no synchronous write of another thread
+  // can come in between and be overwritten in the cache by what was read here
+  bus->lock();
+  uint64_t start = I2CStats::now();
+  uint8_t response;
+  if (first->flags & I2C_REQUEST_BARE) {
+    I2CMessage msg = { first->addr, (uint8_t) (reading ? I2C_MSG_READ : I2C_MSG_WRITE), first->len, first->data };
+    response = bus->transfer(&msg, 1);
+  } else if (reading) {
+    // A single read goes straight into the caller's buffer, a burst is split afterwards
+    uint8_t reg = first->reg;
+    I2CMessage msgs[2] = {
+      { first->addr, I2C_MSG_WRITE, 1, &reg },
+      { first->addr, I2C_MSG_READ, length, n == 1 ? first->data : scratch },
+    };
+    response = bus->transfer(msgs, 2);
+    if (response == I2C_REASON_OK && n > 1) {
+      uint16_t offset = 0;
+      for (uint32_t i = 0; i < n; i++) {
+        memcpy(batch[i]->data, scratch + offset, batch[i]->len);
+        offset += batch[i]->len;
+      }
+    }
+  } else {
+    scratch[0] = first->reg;
+    uint16_t offset = 1;
+    for (uint32_t i = 0; i < n; i++) {
+      memcpy(scratch + offset, batch[i]->data, batch[i]->len);
+      offset += batch[i]->len;
+    }
+    I2CMessage msg = { first->addr, I2C_MSG_WRITE, (uint16_t) (1 + length), scratch };
+    response = bus->transfer(&msg, 1);
+  }
+  uint64_t end = I2CStats::now();
+
+  // Keep the shadow cache in step, as the synchronous calls do
+  I2CRegisterCache *cache = bus->getRegisterCache(first->addr);
+  if (cache && !(first->flags & I2C_REQUEST_BARE)) {
+    if (response == I2C_REASON_OK)
+      cache->store(first->reg, length, reading ? (n == 1 ? first->data : scratch) : scratch + 1);
+    else if (!reading)
+      cache->invalidate(first->reg, length);
+  }
+  // Callbacks run without the lock
+  bus->unlock();
+
+  transfers.fetch_add(1, std::memory_order_relaxed);
+  for (uint32_t i = 0; i < n; i++) {
+    batch[i]->status = response;
+    batch[i]->startNs = start;
+    batch[i]->endNs = end;
+    complete(batch[i]);
+  }
+  return n;
+}
+
+void I2CQueue::run() {
+  I2CRequest *batch[I2C_QUEUE_BATCH];
+  for (;;) {
+    uint32_t count = 0;
+    while (count < I2C_QUEUE_BATCH && (batch[count] = submitted.pop()) != NULL)
+      count++;
+    if (count == 0) {
+      if (stopping.load())
+        break;
+      // Announce the sleep, then look once more before blocking, see submit()
+      idle.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if ((batch[0] = submitted.pop()) != NULL) {
+        count = 1;
+      } else if (!stopping.load()) {
+        uint64_t wakeups;
+        if (read(wakeFd, &wakeups, sizeof(wakeups)) < 0 && errno != EINTR)
+          perror("I2CQueue wait");
+      }
+      idle.store(false);
+      if (count == 0)
+        continue;
+    }
+    if (count > maxBatch.load(std::memory_order_relaxed))
+      maxBatch.store(count, std::memory_order_relaxed);
+    requests.fetch_add(count, std::memory_order_relaxed);
+
+    // Decided up front: a request completed by callback may be resubmitted at once
+    bool reaped = false;
+    for (uint32_t i = 0; i < count; i++)
+      reaped |= batch[i]->callback == NULL;
+    for (uint32_t i = 0; i < count; )
+      i += execute(batch + i, count - i);
+    // One wakeup for the whole batch
+    if (reaped) {
+      uint64_t one = 1;
+      if (write(completionFd, &one, sizeof(one)) < 0)
+        perror("I2CQueue completion");
+    }
+  }
+}
+
+/** Print the request and transfer counts.
+ * @param out Stream to print to
+ */
+void I2CQueue::printStats(FILE *out) const {
+  uint64_t r = requests.load(std::memory_order_relaxed);
+  uint64_t t = transfers.load(std::memory_order_relaxed);
+  fprintf(out, "I2C queue on %s: %llu requests in %llu transfers (%llu merged), %llu failed, largest batch %u\n",
+          bus->name(), (unsigned long long) r, (unsigned long long) t, (unsigned long long) (r - t),
+          (unsigned long long) failures.load(std::memory_order_relaxed), maxBatch.load(std::memory_order_relaxed));
+}
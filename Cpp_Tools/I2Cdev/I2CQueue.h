@@ -0,0 +1,122 @@
+/* I2Cdev library collection - Asynchronous bus queue
+   Lets a thread hand its bus traffic to a bus thread and carry on with other
+   work (building the next record, serving a serial port) while the
+   transfers run, instead of blocking in every I2Cdev call.
+
+   A request describes one register read or write (or a bare one without a
+   register byte) into or from a buffer the caller keeps until completion.
+   submit() puts it into a bounded lock-free queue that any number of
+   threads may feed; the bus thread takes whatever has accumulated and runs
+   it in submission order on the bus, with the bus lock held per transfer
+   and its register shadow cache update. Consecutive reads (or
+   writes) of adjacent registers of one device that are marked
+   I2C_REQUEST_MERGE are coalesced into a single burst, which is only valid
+   for registers that auto-increment.
+
+   A completed request carries its I2C_REASON_* status and the
+   CLOCK_MONOTONIC times its transfer started and ended. It is handed back
+   through its callback, called on the bus thread (keep it short), or, with
+   no callback, through a completion queue: the completion eventfd becomes
+   readable and reap() returns the requests. The eventfd is non-blocking and
+   meant to be watched by the caller's epoll loop.
+*/
+
+#ifndef _I2CQUEUE_H_
+#define _I2CQUEUE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <atomic>
+#include <thread>
+#include "I2CBus.h"
+
+// Requests queued or awaiting reap() at most, a power of two
+#define I2C_QUEUE_CAPACITY 256
+// Longest burst coalesced requests are combined into, and longest register write
+#define I2C_QUEUE_MERGE_MAX 255
+
+// Request flags
+#define I2C_REQUEST_READ  0x01      // else a write
+#define I2C_REQUEST_BARE  0x02      // no register byte, e.g. an HMC6343 command or answer
+#define I2C_REQUEST_MERGE 0x04      // may be coalesced with neighbouring registers
+
+typedef struct i2c_request I2CRequest;
+typedef void (*I2CCompletion)(I2CRequest *request, void *context);
+
+struct i2c_request {
+    uint8_t addr;               // 7-bit slave address
+    uint8_t reg;                // register, unless I2C_REQUEST_BARE
+    uint8_t flags;              // I2C_REQUEST_*
+    uint16_t len;               // bytes to read or write
+    uint8_t *data;              // destination or source, owned by the caller until completion
+    I2CCompletion callback;     // NULL to complete through reap()
+    void *context;              // passed to the callback
+    // Set on completion
+    uint8_t status;             // I2C_REASON_*
+    uint64_t startNs;           // transfer start and end, CLOCK_MONOTONIC
+    uint64_t endNs;
+};
+
+/** Bounded lock-free multi-producer/multi-consumer queue of request pointers.
+ * Each slot carries a sequence number telling whose turn it is, so pushing
+ * and popping are one CAS on the respective index and never wait.
+ */
+class I2CRequestRing {
+ public:
+    I2CRequestRing();
+
+    bool push(I2CRequest *request);
+    I2CRequest *pop();
+
+ private:
+    typedef struct cell {
+        std::atomic<uint32_t> sequence;
+        I2CRequest *request;
+    } Cell;
+
+    Cell cells[I2C_QUEUE_CAPACITY];
+    alignas(64) std::atomic<uint32_t> enqueuePos;
+    alignas(64) std::atomic<uint32_t> dequeuePos;
+};
+
+class I2CQueue {
+ public:
+    I2CQueue(I2CBus *bus = NULL);
+    ~I2CQueue();
+
+    bool start();
+    void stop();
+
+    bool submit(I2CRequest *request);
+    int getCompletionFD() const { return completionFd; }
+    uint32_t reap(I2CRequest **requests, uint32_t max);
+
+    // Bus thread while running, e.g. for RealTime::configureThread()
+    pthread_t getThread() { return thread.native_handle(); }
+    void printStats(FILE *out) const;
+
+ private:
+    I2CBus *bus;
+    I2CRequestRing submitted;
+    I2CRequestRing completed;
+    std::atomic<uint32_t> pending;      // submitted and not yet handed back
+    std::atomic<bool> idle;             // bus thread is about to block
+    std::atomic<bool> stopping;
+    int wakeFd;
+    int completionFd;
+    std::thread thread;
+    uint8_t scratch[1 + I2C_QUEUE_MERGE_MAX];  // register byte and a merged burst
+
+    // Written by the bus thread only
+    std::atomic<uint64_t> requests;
+    std::atomic<uint64_t> transfers;
+    std::atomic<uint64_t> failures;
+    std::atomic<uint32_t> maxBatch;
+
+    void run();
+    uint32_t execute(I2CRequest **batch, uint32_t count);
+    void complete(I2CRequest *request);
+};
+
+#endif /* _I2CQUEUE_H_ */
@@ -0,0 +1,123 @@
+// I2Cdev library collection - Register shadow cache
+// Host-side copy of a device's configuration registers.
+
+#include "I2CRegisterCache.h"
+#include <string.h>
+
+#define BIT_SET(map, reg) ((map)[(reg) >> 3] & (1 << ((reg) & 7)))
+
+/** Build a cache for one device.
+ * @param cacheable Ranges of configuration registers that only change when written
+ * @param rangeCount Number of entries in cacheable
+ * @param selfClearing Registers with bits that clear themselves after a write
+ * @param selfClearingCount Number of entries in selfClearing
+ */
+I2CRegisterCache::I2CRegisterCache(const I2CRegisterRange *cacheable, uint8_t rangeCount,
+                                   const I2CSelfClearingBits *selfClearing, uint8_t selfClearingCount) {
+  memset(this->cacheable, 0, sizeof(this->cacheable));
+  memset(clearMask, 0, sizeof(clearMask));
+  for (uint8_t i = 0; i < rangeCount; i++) {
+    for (uint16_t reg = cacheable[i].first; reg <= cacheable[i].last; reg++) {
+      this->cacheable[reg >> 3] |= 1 << (reg & 7);
+    }
+  }
+  for (uint8_t i = 0; i < selfClearingCount; i++) {
+    clearMask[selfClearing[i].reg] = selfClearing[i].mask;
+  }
+  invalidate();
+}
+
+/** Build a cache for one device from its register map.
+ * @param registers Register descriptions, registers not listed are volatile
+ * @param count Number of entries in registers
+ */
+I2CRegisterCache::I2CRegisterCache(const I2CRegisterInfo *registers, uint16_t count) {
+  memset(cacheable, 0, sizeof(cacheable));
+  memset(clearMask, 0, sizeof(clearMask));
+  for (uint16_t i = 0; i < count; i++) {
+    if (registers[i].flags & I2C_REGISTER_CACHEABLE)
+      cacheable[registers[i].addr >> 3] |= 1 << (registers[i].addr & 7);
+    clearMask[registers[i].addr] = registers[i].selfClearing;
+  }
+  invalidate();
+}
+
+bool I2CRegisterCache::isCacheable(uint8_t reg) const {
+  return BIT_SET(cacheable, reg);
+}
+
+/** Check that every register of a burst is cacheable.
+ * @param reg First register of the burst
+ * @param length Number of consecutive registers
+ */
+bool I2CRegisterCache::isCacheable(uint8_t reg, uint16_t length) const {
+  if (reg + length > 256)
+    return false;
+  for (uint16_t i = reg; i < reg + length; i++) {
+    if (!BIT_SET(cacheable, i))
+      return false;
+  }
+  return true;
+}
+
+/** Get a register from the cache.
+ * @param reg Register to look up
+ * @param value Container for the cached value
+ * @return True if the register is cacheable and currently known
+ */
+bool I2CRegisterCache::lookup(uint8_t reg, uint8_t *value) const {
+  if (!BIT_SET(valid, reg))
+    return false;
+  *value = values[reg];
+  return true;
+}
+
+/** Get a burst of consecutive registers from the cache.
+ * @return True only if every register in the burst is known
+ */
+bool I2CRegisterCache::lookup(uint8_t reg, uint16_t length, uint8_t *data) const {
+  if (reg + length > 256)
+    return false;
+  for (uint16_t i = reg; i < reg + length; i++) {
+    if (!BIT_SET(valid, i))
+      return false;
+  }
+  memcpy(data, &values[reg], length);
+  return true;
+}
+
+/** Record a value written to or read from a register.
+ * Non-cacheable registers are ignored, self-clearing bits are dropped.
+ */
+void I2CRegisterCache::store(uint8_t reg, uint8_t value) {
+  if (!BIT_SET(cacheable, reg))
+    return;
+  values[reg] = value & ~clearMask[reg];
+  valid[reg >> 3] |= 1 << (reg & 7);
+}
+
+/** Record a burst of consecutive registers.
+ * Used for auto-incrementing bursts only; a burst starting at a FIFO or memory
+ * port is never stored because that start register is not cacheable.
+ */
+void I2CRegisterCache::store(uint8_t reg, uint16_t length, const uint8_t *data) {
+  if (!BIT_SET(cacheable, reg))
+    return;
+  for (uint16_t i = 0; i < length && reg + i < 256; i++) {
+    store(reg + i, data[i]);
+  }
+}
+
+/** Forget every cached register, e.g. after a device reset.
+ */
+void I2CRegisterCache::invalidate() {
+  memset(valid, 0, sizeof(valid));
+}
+
+/** Forget a range of registers, e.g. after a failed write.
+ */
+void I2CRegisterCache::invalidate(uint8_t reg, uint16_t length) {
+  for (uint16_t i = reg; i < reg + length && i < 256; i++) {
+    valid[i >> 3] &= ~(1 << (i & 7));
+  }
+}
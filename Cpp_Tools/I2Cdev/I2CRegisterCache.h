@@ -0,0 +1,70 @@
+/* I2Cdev library collection - Register shadow cache
+   Keeps a host-side copy of a device's configuration registers so that
+   bit-level writes do not need to read the register back first, and so that
+   configuration getters can be answered without touching the bus.
+
+   Only registers declared cacheable are ever stored. Everything else (sensor
+   data, status, FIFO and memory ports) is treated as volatile and always goes
+   to the device. Self-clearing bits (resets, one-shot triggers) are masked out
+   of the stored value so that a later read-modify-write does not re-trigger
+   them.
+
+   Both can be given as one register map (I2CRegisterInfo, see
+   I2CRegisterMap.h) that the device driver's field accessors are checked
+   against too, so there is a single description of the register file.
+
+   The cache assumes the process is the only writer of the device. Anything
+   that changes the register file behind its back (a device reset, another
+   process, a power cycle) must be followed by invalidate() or a resync.
+*/
+
+#ifndef _I2CREGISTERCACHE_H_
+#define _I2CREGISTERCACHE_H_
+
+#include <stdint.h>
+
+typedef struct i2c_register_range {
+    uint8_t first;  // first register in the range
+    uint8_t last;   // last register in the range (inclusive)
+} I2CRegisterRange;
+
+typedef struct i2c_self_clearing_bits {
+    uint8_t reg;    // register containing self-clearing bits
+    uint8_t mask;   // bits that read back as zero after being written
+} I2CSelfClearingBits;
+
+// Register flags
+#define I2C_REGISTER_CACHEABLE 0x01     // only changes when written
+
+typedef struct i2c_register_info {
+    uint8_t addr;
+    uint8_t flags;          // I2C_REGISTER_*
+    uint8_t selfClearing;   // bits that read back as zero after being written
+} I2CRegisterInfo;
+
+class I2CRegisterCache {
+ public:
+    I2CRegisterCache(const I2CRegisterRange *cacheable, uint8_t rangeCount,
+                     const I2CSelfClearingBits *selfClearing=0, uint8_t selfClearingCount=0);
+    I2CRegisterCache(const I2CRegisterInfo *registers, uint16_t count);
+
+    bool isCacheable(uint8_t reg) const;
+    bool isCacheable(uint8_t reg, uint16_t length) const;
+
+    bool lookup(uint8_t reg, uint8_t *value) const;
+    bool lookup(uint8_t reg, uint16_t length, uint8_t *data) const;
+
+    void store(uint8_t reg, uint8_t value);
+    void store(uint8_t reg, uint16_t length, const uint8_t *data);
+
+    void invalidate();
+    void invalidate(uint8_t reg, uint16_t length=1);
+
+ private:
+    uint8_t cacheable[32];
+    uint8_t valid[32];
+    uint8_t clearMask[256];
+    uint8_t values[256];
+};
+
+#endif /* _I2CREGISTERCACHE_H_ */
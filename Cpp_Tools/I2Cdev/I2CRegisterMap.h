@@ -0,0 +1,104 @@
+/* I2Cdev library collection - Compile-time register map and field accessors
+   A device driver describes its register file once, as a constexpr table of
+   I2CRegisterInfo (address, cacheability, self-clearing bits) that also
+   builds its register shadow cache, and its bit fields as I2CField types
+   naming the register, the field's top bit and its width, numbered like
+   I2CBus::readBits(). Masks and shifts are constants of the field type, so
+   a field access compiles down to a register access and a constant mask.
+
+   I2CRegisterUpdate collects updates of several fields of one register and
+   writes them with a single read-modify-write (none at all when the fields
+   cover the whole register), so a multi-field configuration change is one
+   bus transaction. Setting a field of another register fails to compile.
+
+   i2cRegisterDescribed(), i2cRegisterFlags() and i2cSelfClearingBits()
+   look registers up in a map at compile time, for drivers to static_assert
+   their fields against it.
+*/
+
+#ifndef _I2CREGISTERMAP_H_
+#define _I2CREGISTERMAP_H_
+
+#include <stdint.h>
+#include "I2CBus.h"
+#include "I2CRegisterCache.h"
+
+template <uint8_t Reg, uint8_t BitStart, uint8_t Length, typename T = uint8_t>
+struct I2CField {
+    static_assert(BitStart < 8 && Length >= 1 && Length <= BitStart + 1, "field must lie within one 8-bit register");
+
+    typedef T Type;
+    static constexpr uint8_t reg = Reg;
+    static constexpr uint8_t shift = BitStart + 1 - Length;
+    static constexpr uint8_t mask = (uint8_t) (((1u << Length) - 1) << shift);
+
+    static constexpr uint8_t encode(T value) { return (uint8_t) (((unsigned) value << shift) & mask); }
+    static constexpr T decode(uint8_t raw) { return (T) ((raw & mask) >> shift); }
+};
+
+// Single-bit flag
+template <uint8_t Reg, uint8_t Bit>
+using I2CFlag = I2CField<Reg, Bit, 1, bool>;
+
+/** Read one field.
+ * @param value Container for the field, right-aligned
+ * @return Status of read operation (true = success)
+ */
+template <typename F>
+bool i2cReadField(I2CBus *bus, uint8_t devAddr, typename F::Type *value) {
+    uint8_t b;
+    if (!bus->readByte(devAddr, F::reg, &b))
+        return false;
+    *value = F::decode(b);
+    return true;
+}
+
+/** Write one field, leaving the rest of its register.
+ * @return Status of operation (true = success)
+ */
+template <typename F>
+bool i2cWriteField(I2CBus *bus, uint8_t devAddr, typename F::Type value) {
+    return bus->writeMasked(devAddr, F::reg, F::mask, F::encode(value));
+}
+
+/** Updates of several fields of register Reg, written in one transaction:
+ *   I2CRegisterUpdate<REG>().set<FieldA>(a).set<FieldB>(b).write(bus, devAddr)
+ */
+template <uint8_t Reg>
+class I2CRegisterUpdate {
+ public:
+    I2CRegisterUpdate() : mask(0), bits(0) { }
+
+    template <typename F>
+    I2CRegisterUpdate &set(typename F::Type value) {
+        static_assert(F::reg == Reg, "field belongs to another register");
+        mask |= F::mask;
+        bits = (bits & ~F::mask) | F::encode(value);
+        return *this;
+    }
+
+    bool write(I2CBus *bus, uint8_t devAddr) const {
+        return mask == 0 || bus->writeMasked(devAddr, Reg, mask, bits);
+    }
+
+ private:
+    uint8_t mask;
+    uint8_t bits;
+};
+
+// Whether reg is described in a register map
+constexpr bool i2cRegisterDescribed(const I2CRegisterInfo *map, uint16_t count, uint8_t reg) {
+    return count > 0 && (map->addr == reg || i2cRegisterDescribed(map + 1, count - 1, reg));
+}
+
+// I2C_REGISTER_* flags of reg in a register map, 0 if it is not described
+constexpr uint8_t i2cRegisterFlags(const I2CRegisterInfo *map, uint16_t count, uint8_t reg) {
+    return count == 0 ? 0 : map->addr == reg ? map->flags : i2cRegisterFlags(map + 1, count - 1, reg);
+}
+
+// Self-clearing bits of reg in a register map
+constexpr uint8_t i2cSelfClearingBits(const I2CRegisterInfo *map, uint16_t count, uint8_t reg) {
+    return count == 0 ? 0 : map->addr == reg ? map->selfClearing : i2cSelfClearingBits(map + 1, count - 1, reg);
+}
+
+#endif /* _I2CREGISTERMAP_H_ */
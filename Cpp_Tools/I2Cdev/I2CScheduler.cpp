@@ -0,0 +1,196 @@
+// I2Cdev library collection - Deadline-aware bus scheduler
+// Earliest-deadline-first execution of split device transactions on one bus.
+
+#include "I2CScheduler.h"
+#include "I2Cdev.h"
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+/**
+ * @param bus Bus the tasks run on, NULL for the default bus
+ */
+I2CScheduler::I2CScheduler(I2CBus *bus) :
+    bus(bus ? bus : I2CBus::getDefault()), taskCount(0), stopping(false), sleeps(0), wakeupSumNs(0), maxWakeupNs(0) {
+  memset(tasks, 0, sizeof(tasks));
+}
+
+I2CScheduler::~I2CScheduler() {
+  stop();
+}
+
+/** Current CLOCK_MONOTONIC time, the time base of all releases and deadlines.
+ * @return Nanoseconds
+ */
+uint64_t I2CScheduler::now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/** Register a periodic task. Must be called before start().
+ * @param name Label for printStats()
+ * @param phase Called once per phase with the bus lock held
+ * @param context Passed to phase
+ * @param periodNs Release period
+ * @param deadlineNs Deadline relative to each release, normally the period
+ * @param priority Tie-break between equal deadlines, and which tasks may hold
+ *                 back the phases of others; lower is more important
+ * @return Task index for getStats(), or -1 if the table is full
+ */
+int I2CScheduler::addTask(const char *name, I2CTaskPhase phase, void *context,
+                          uint64_t periodNs, uint64_t deadlineNs, uint8_t priority) {
+  if (taskCount >= I2C_SCHEDULER_MAX_TASKS || periodNs == 0)
+    return -1;
+  Task *task = &tasks[taskCount];
+  memset(task, 0, sizeof(*task));
+  task->name = name;
+  task->phase = phase;
+  task->context = context;
+  task->period = periodNs;
+  task->relativeDeadline = deadlineNs ? deadlineNs : periodNs;
+  task->priority = priority;
+  return taskCount++;
+}
+
+/** Start the scheduler thread.
+ * @param epoch First release of every task, so tasks with related periods stay in phase
+ * @return False if there is nothing to run or it is already running
+ */
+bool I2CScheduler::start(uint64_t epoch) {
+  if (taskCount == 0 || thread.joinable())
+    return false;
+  for (int i = 0; i < taskCount; i++) {
+    tasks[i].active = false;
+    tasks[i].nextRelease = epoch;
+    memset(&tasks[i].stats, 0, sizeof(tasks[i].stats));
+  }
+  sleeps = wakeupSumNs = maxWakeupNs = 0;
+  stopping.store(false);
+  thread = std::thread(&I2CScheduler::run, this);
+  return true;
+}
+
+/** Stop after the phase in progress, abandoning any unfinished jobs.
+ */
+void I2CScheduler::stop() {
+  if (!thread.joinable())
+    return;
+  stopping.store(true, std::memory_order_release);
+  thread.join();
+}
+
+// Start the job for the latest release that has passed. Releases that passed
+// while the previous job was still running are dropped and counted.
+void I2CScheduler::release(Task *task, uint64_t now) {
+  uint64_t missed = (now - task->nextRelease) / task->period;
+  task->job.release = task->nextRelease + missed * task->period;
+  task->job.deadline = task->job.release + task->relativeDeadline;
+  task->job.skipped = missed;
+  task->job.phase = 0;
+  task->stats.skipped += missed;
+  task->nextRelease = task->job.release + task->period;
+  task->ready = task->job.release;
+  task->active = true;
+}
+
+// Choose the phase to run now, or NULL with the time the next one becomes ready
+I2CScheduler::Task *I2CScheduler::pick(uint64_t now, uint64_t *wake) {
+  Task *best = NULL;
+  *wake = now + I2C_SCHEDULER_MAX_SLEEP_NS;
+  for (int i = 0; i < taskCount; i++) {
+    Task *task = &tasks[i];
+    if (!task->active && task->nextRelease <= now)
+      release(task, now);
+    if (!task->active) {
+      if (task->nextRelease < *wake)
+        *wake = task->nextRelease;
+    } else if (task->ready > now) {
+      if (task->ready < *wake)
+        *wake = task->ready;
+    } else if (best == NULL || task->job.deadline < best->job.deadline ||
+               (task->job.deadline == best->job.deadline && task->priority < best->priority)) {
+      best = task;
+    }
+  }
+  if (best == NULL)
+    return NULL;
+
+  // Hold the phase back if a more important task becomes ready before it would end
+  uint64_t end = now + best->stats.maxPhaseNs;
+  for (int i = 0; i < taskCount; i++) {
+    Task *task = &tasks[i];
+    if (task->priority >= best->priority)
+      continue;
+    uint64_t ready = task->active ? task->ready : task->nextRelease;
+    uint64_t deadline = task->active ? task->job.deadline : task->nextRelease + task->relativeDeadline;
+    if (ready > now && ready < end && deadline < best->job.deadline) {
+      *wake = ready;
+      return NULL;
+    }
+  }
+  return best;
+}
+
+void I2CScheduler::run() {
+  while (!stopping.load(std::memory_order_acquire)) {
+    uint64_t start = now();
+    uint64_t wake;
+    Task *task = pick(start, &wake);
+    if (task == NULL) {
+      struct timespec ts;
+      ts.tv_sec = wake / 1000000000ull;
+      ts.tv_nsec = wake % 1000000000ull;
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+      uint64_t late = now() - wake;
+      sleeps++;
+      wakeupSumNs += late;
+      if (late > maxWakeupNs)
+        maxWakeupNs = late;
+      continue;
+    }
+
+    I2CTaskStats *stats = &task->stats;
+    if (task->job.phase == 0) {
+      task->job.start = start;
+      if (start - task->job.release > stats->maxStartDelayNs)
+        stats->maxStartDelayNs = start - task->job.release;
+    }
+    int64_t wait;
+    {
+      I2CBusLock lock(bus);
+      wait = task->phase(task->context, &task->job);
+    }
+    uint64_t end = now();
+    if (end - start > stats->maxPhaseNs)
+      stats->maxPhaseNs = end - start;
+
+    if (wait == I2C_JOB_DONE) {
+      task->active = false;
+      stats->jobs++;
+      if (end - task->job.release > stats->maxResponseNs)
+        stats->maxResponseNs = end - task->job.release;
+      if (end > task->job.deadline)
+        stats->deadlineMisses++;
+    } else {
+      task->job.phase++;
+      task->ready = end + (wait > 0 ? wait : 0);
+    }
+  }
+}
+
+/** One line per task, e.g. at shutdown after stop().
+ */
+void I2CScheduler::printStats(FILE *out) const {
+  for (int i = 0; i < taskCount; i++) {
+    const I2CTaskStats *stats = &tasks[i].stats;
+    fprintf(out, "%s: %llu jobs, %llu deadline misses, %llu releases skipped, "
+            "worst start delay %0.3f ms, worst response %0.3f ms, longest phase %0.3f ms\n",
+            tasks[i].name, (unsigned long long) stats->jobs,
+            (unsigned long long) stats->deadlineMisses, (unsigned long long) stats->skipped,
+            stats->maxStartDelayNs / 1e6, stats->maxResponseNs / 1e6, stats->maxPhaseNs / 1e6);
+  }
+  fprintf(out, "Bus thread: %llu sleeps, wakeup latency mean %0.1f us, worst %0.1f us\n",
+          (unsigned long long) sleeps, sleeps ? wakeupSumNs / 1e3 / sleeps : 0.0, maxWakeupNs / 1e3);
+}
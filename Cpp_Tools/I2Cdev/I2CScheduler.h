@@ -0,0 +1,113 @@
+/* I2Cdev library collection - Deadline-aware bus scheduler
+   Runs the periodic work of several devices on one bus from a single thread.
+
+   Each task is released every period and has to finish within its relative
+   deadline. A job is split into phases: every phase is one short, atomic
+   burst of bus traffic, and returns how long the device needs before the
+   next phase may run (for example the HMC6343 response time between a
+   command and its answer). While one job waits, the bus serves the others.
+
+   Among the phases that are ready the one with the earliest absolute
+   deadline runs first, ties going to the lower priority number. Phases are
+   never preempted, so a phase of a less urgent task is held back when a
+   task with a lower priority number is released before that phase would
+   be expected to finish. The expected length is the longest phase seen so
+   far for the task. This keeps a fast sensor's service jitter down to its
+   own transaction time instead of the slowest transaction on the bus.
+
+   Each phase runs with the lock of the scheduler's bus held, so other
+   threads can still use the bus between phases. Sensors on separate buses
+   get a scheduler each and run in parallel. Times are CLOCK_MONOTONIC ns.
+   How late the thread wakes from its sleeps is tracked as well, which is
+   the scheduling latency the sensors see.
+*/
+
+#ifndef _I2CSCHEDULER_H_
+#define _I2CSCHEDULER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <atomic>
+#include <thread>
+#include "I2CBus.h"
+
+#define I2C_SCHEDULER_MAX_TASKS 8
+// Longest the scheduler thread sleeps before checking for stop()
+#define I2C_SCHEDULER_MAX_SLEEP_NS 50000000ull
+
+// Returned by a phase when the job is complete
+#define I2C_JOB_DONE -1
+
+typedef struct i2c_job {
+    uint64_t release;       // when the job became ready
+    uint64_t deadline;      // absolute deadline
+    uint64_t start;         // when its first phase ran
+    uint32_t skipped;       // releases dropped before this one because of an overrun
+    uint8_t phase;          // 0 for the first phase
+} I2CJob;
+
+/** Run one phase of a job.
+ * @return Nanoseconds until the next phase may run, or I2C_JOB_DONE
+ */
+typedef int64_t (*I2CTaskPhase)(void *context, const I2CJob *job);
+
+typedef struct i2c_task_stats {
+    uint64_t jobs;
+    uint64_t deadlineMisses;    // jobs finished after their deadline
+    uint64_t skipped;           // releases dropped because the previous job was still running
+    uint64_t maxStartDelayNs;   // worst time from release to the first phase
+    uint64_t maxResponseNs;     // worst time from release to completion
+    uint64_t maxPhaseNs;        // longest single phase
+} I2CTaskStats;
+
+class I2CScheduler {
+ public:
+    I2CScheduler(I2CBus *bus = NULL);
+    ~I2CScheduler();
+
+    int addTask(const char *name, I2CTaskPhase phase, void *context,
+                uint64_t periodNs, uint64_t deadlineNs, uint8_t priority);
+
+    bool start(uint64_t epoch);
+    void stop();
+
+    const I2CTaskStats *getStats(int task) const { return &tasks[task].stats; }
+    void printStats(FILE *out) const;
+    uint64_t getMaxWakeupLatency() const { return maxWakeupNs; }
+
+    // Scheduler thread while running, e.g. for RealTime::configureThread()
+    pthread_t getThread() { return thread.native_handle(); }
+
+    static uint64_t now();
+
+ private:
+    typedef struct task {
+        const char *name;
+        I2CTaskPhase phase;
+        void *context;
+        uint64_t period;
+        uint64_t relativeDeadline;
+        uint8_t priority;
+        bool active;            // job released and not yet complete
+        uint64_t ready;         // earliest time the next phase may run
+        uint64_t nextRelease;
+        I2CJob job;
+        I2CTaskStats stats;
+    } Task;
+
+    I2CBus *bus;
+    Task tasks[I2C_SCHEDULER_MAX_TASKS];
+    int taskCount;
+    std::thread thread;
+    std::atomic<bool> stopping;
+    uint64_t sleeps;
+    uint64_t wakeupSumNs;
+    uint64_t maxWakeupNs;   // worst time from a wake time to the thread running
+
+    void run();
+    void release(Task *task, uint64_t now);
+    Task *pick(uint64_t now, uint64_t *wake);
+};
+
+#endif /* _I2CSCHEDULER_H_ */
@@ -0,0 +1,200 @@
+// I2Cdev library collection - Simulated HMC6343
+
+#include "I2CSimHMC6343.h"
+#include <string.h>
+#include <math.h>
+
+// Commands and EEPROM locations of the model, numbered as in HMC6343.h
+#define CMD_POST_ACCEL       0x40
+#define CMD_POST_MAG         0x45
+#define CMD_POST_HEADING     0x50
+#define CMD_POST_TILT        0x55
+#define CMD_POST_OPMODE1     0x65
+#define CMD_ENTER_CAL        0x71
+#define CMD_ORIENT_LEVEL     0x72
+#define CMD_ORIENT_SIDEWAYS  0x73
+#define CMD_ORIENT_FLATFRONT 0x74
+#define CMD_ENTER_RUN        0x75
+#define CMD_ENTER_STANDBY    0x76
+#define CMD_EXIT_CAL         0x7E
+#define CMD_RESET            0x82
+#define CMD_ENTER_SLEEP      0x83
+#define CMD_EXIT_SLEEP       0x84
+#define CMD_READ_EEPROM      0xE1
+#define CMD_WRITE_EEPROM     0xF1
+
+#define EE_SLAVE_ADDR 0x00
+#define EE_SW_VERSION 0x02
+#define EE_OP_MODE1   0x04
+#define EE_OP_MODE2   0x05
+#define EE_SN_LSB     0x06
+#define EE_DATE_YY    0x08
+#define EE_DATE_WW    0x09
+#define EE_XOFFSET    0x0E
+
+#define OM1_ORIENTATION 0x07
+#define OM1_STANDBY     0x08
+#define OM1_RUN         0x10
+#define OM1_CAL         0x40
+
+// Response times from the datasheet, ns
+#define RESPONSE_NS        1000000ull
+#define EEPROM_NS         10000000ull
+#define EXIT_CAL_NS       50000000ull
+#define RESET_NS         500000000ull
+#define EXIT_SLEEP_NS     20000000ull
+
+// Hard-iron offset of the simulated installation, in output counts (mG)
+static const int16_t hardIron[3] = { 35, -20, 12 };
+
+I2CSimHMC6343::I2CSimHMC6343() {
+  memset(eeprom, 0, sizeof(eeprom));
+  eeprom[EE_SLAVE_ADDR] = 0x32;
+  eeprom[EE_SW_VERSION] = 0x15;
+  eeprom[EE_OP_MODE1] = OM1_RUN | 0x01;     // level, running
+  eeprom[EE_OP_MODE2] = 0x01;               // 5 Hz
+  eeprom[EE_SN_LSB] = 0x34;
+  eeprom[EE_SN_LSB + 1] = 0x12;
+  eeprom[EE_DATE_YY] = 14;
+  eeprom[EE_DATE_WW] = 29;
+  reset();
+}
+
+// Processor reset: OP_MODE1 reloads from the EEPROM
+void I2CSimHMC6343::reset() {
+  opMode1 = eeprom[EE_OP_MODE1];
+  sleeping = false;
+  busyUntil = 0;
+  answerLength = 0;
+  measured = 0;
+}
+
+// Bring the outputs up to the latest measurement due by now
+void I2CSimHMC6343::measure(uint64_t nowNs) {
+  static const uint32_t rateHz[4] = { 1, 5, 10, 10 };
+  uint64_t period = 1000000000ull / rateHz[eeprom[EE_OP_MODE2] & 0x03];
+  uint64_t t = nowNs - nowNs % period;
+  if (measured != 0 && (t == measured || !(opMode1 & OM1_RUN)))
+    return;
+  measured = t;
+
+  I2CSimMotion m;
+  I2CSimTransport::motion(t / 1e9, &m);
+  heading = (int16_t) lrint(m.yaw * 1800 / M_PI) % 3600;
+  pitch = (int16_t) lrint(m.pitch * 1800 / M_PI);
+  roll = (int16_t) lrint(m.roll * 1800 / M_PI);
+  for (int i = 0; i < 3; i++) {
+    int16_t offset = (int16_t) (eeprom[EE_XOFFSET + 2 * i] | eeprom[EE_XOFFSET + 2 * i + 1] << 8);
+    mag[i] = (int16_t) lrint(m.field[i] * 1000) + hardIron[i] - offset;
+    accel[i] = (int16_t) lrint(m.gravity[i] * 1024);
+  }
+  temperature = 250;
+}
+
+void I2CSimHMC6343::setAnswer(int16_t first, int16_t second, int16_t third) {
+  int16_t values[3] = { first, second, third };
+  for (int i = 0; i < 3; i++) {
+    answer[2 * i] = (uint16_t) values[i] >> 8;
+    answer[2 * i + 1] = values[i] & 0xFF;
+  }
+  answerLength = 6;
+}
+
+/** A command, with its EEPROM location and data if it takes them.
+ */
+bool I2CSimHMC6343::write(const uint8_t *data, uint16_t len, uint64_t nowNs) {
+  if (nowNs < busyUntil || len == 0)
+    return false;
+  uint8_t command = data[0];
+  if (sleeping && command != CMD_EXIT_SLEEP)
+    return false;
+
+  answerLength = 0;
+  uint64_t busy = RESPONSE_NS;
+  switch (command) {
+    case CMD_POST_ACCEL:
+      measure(nowNs);
+      setAnswer(accel[0], accel[1], accel[2]);
+      break;
+    case CMD_POST_MAG:
+      measure(nowNs);
+      setAnswer(mag[0], mag[1], mag[2]);
+      break;
+    case CMD_POST_HEADING:
+      measure(nowNs);
+      setAnswer(heading, pitch, roll);
+      break;
+    case CMD_POST_TILT:
+      measure(nowNs);
+      setAnswer(pitch, roll, temperature);
+      break;
+    case CMD_POST_OPMODE1:
+      answer[0] = opMode1;
+      answerLength = 1;
+      break;
+    case CMD_READ_EEPROM:
+      if (len < 2)
+        return false;
+      answer[0] = eeprom[data[1]];
+      answerLength = 1;
+      busy = EEPROM_NS;
+      break;
+    case CMD_WRITE_EEPROM:
+      if (len < 3)
+        return false;
+      eeprom[data[1]] = data[2];
+      busy = EEPROM_NS;
+      break;
+    case CMD_ENTER_CAL:
+      opMode1 |= OM1_CAL;
+      break;
+    case CMD_EXIT_CAL:
+      // The offsets found during calibration are stored in the EEPROM
+      if (opMode1 & OM1_CAL) {
+        for (int i = 0; i < 3; i++) {
+          eeprom[EE_XOFFSET + 2 * i] = (uint16_t) hardIron[i] & 0xFF;
+          eeprom[EE_XOFFSET + 2 * i + 1] = (uint16_t) hardIron[i] >> 8;
+        }
+      }
+      opMode1 &= ~OM1_CAL;
+      measured = 0;
+      busy = EXIT_CAL_NS;
+      break;
+    case CMD_ORIENT_LEVEL:
+    case CMD_ORIENT_SIDEWAYS:
+    case CMD_ORIENT_FLATFRONT:
+      opMode1 = (opMode1 & ~OM1_ORIENTATION) | 1 << (command - CMD_ORIENT_LEVEL);
+      break;
+    case CMD_ENTER_RUN:
+      opMode1 = (opMode1 & ~OM1_STANDBY) | OM1_RUN;
+      break;
+    case CMD_ENTER_STANDBY:
+      opMode1 = (opMode1 & ~OM1_RUN) | OM1_STANDBY;
+      break;
+    case CMD_RESET:
+      reset();
+      busy = RESET_NS;
+      break;
+    case CMD_ENTER_SLEEP:
+      sleeping = true;
+      break;
+    case CMD_EXIT_SLEEP:
+      sleeping = false;
+      busy = EXIT_SLEEP_NS;
+      break;
+    default:
+      break;
+  }
+  busyUntil = nowNs + busy;
+  return true;
+}
+
+/** The answer to the last command, once its response time has passed.
+ */
+bool I2CSimHMC6343::read(uint8_t *data, uint16_t len, uint64_t nowNs) {
+  if (nowNs < busyUntil || sleeping || answerLength == 0)
+    return false;
+  for (uint16_t i = 0; i < len; i++)
+    data[i] = i < answerLength ? answer[i] : 0xFF;
+  return true;
+}
@@ -0,0 +1,46 @@
+/* I2Cdev library collection - Simulated HMC6343
+   Model of the compass's command/response protocol:
+
+   - A command is a one-byte write, EEPROM access adds the location and
+     data. Commands that answer (POST_*, POST_OPMODE1, READ_EEPROM) make
+     the answer readable after their response time (1 ms, 10 ms for the
+     EEPROM). Until then the device is busy and NACKs every access, as it
+     does after WRITE_EEPROM, EXIT_CAL (50 ms), RESET (500 ms) and
+     EXIT_SLEEP (20 ms). Asleep it only acknowledges EXIT_SLEEP.
+   - The EEPROM with its factory contents. OP_MODE1 is loaded from it at
+     reset, the measurement rate is taken from OP_MODE2 as it is written.
+   - OP_MODE1 tracks the orientation, run/standby and calibration commands.
+   - Measurements are refreshed at the OP_MODE2 rate while running and
+     frozen in standby. The magnetometer carries a hard-iron offset less
+     the EEPROM offsets; leaving calibration mode stores the offset that
+     cancels it. Outputs are in the level frame whatever the orientation.
+*/
+
+#ifndef _I2CSIMHMC6343_H_
+#define _I2CSIMHMC6343_H_
+
+#include "I2CSimTransport.h"
+
+class I2CSimHMC6343 : public I2CSimDevice {
+ public:
+    I2CSimHMC6343();
+
+    bool write(const uint8_t *data, uint16_t len, uint64_t nowNs);
+    bool read(uint8_t *data, uint16_t len, uint64_t nowNs);
+
+ private:
+    uint8_t eeprom[256];
+    uint8_t opMode1;
+    bool sleeping;
+    uint64_t busyUntil;             // NACK everything before this
+    uint8_t answer[6];
+    uint8_t answerLength;           // 0 when the last command has no answer
+    uint64_t measured;              // time of the current measurement
+    int16_t heading, pitch, roll, mag[3], accel[3], temperature;
+
+    void reset();
+    void measure(uint64_t nowNs);
+    void setAnswer(int16_t first, int16_t second, int16_t third);
+};
+
+#endif /* _I2CSIMHMC6343_H_ */
@@ -0,0 +1,288 @@
+// I2Cdev library collection - Simulated MPU6050
+
+#include "I2CSimMPU6050.h"
+#include <string.h>
+#include <math.h>
+
+// Registers and bits of the model, numbered as in MPU6050.h
+#define REG_SMPLRT_DIV    0x19
+#define REG_CONFIG        0x1A
+#define REG_GYRO_CONFIG   0x1B
+#define REG_ACCEL_CONFIG  0x1C
+#define REG_FIFO_EN       0x23
+#define REG_INT_ENABLE    0x38
+#define REG_INT_STATUS    0x3A
+#define REG_ACCEL_XOUT_H  0x3B
+#define REG_DATA_END      0x60   // last of the sensor and external sensor data
+#define REG_USER_CTRL     0x6A
+#define REG_PWR_MGMT_1    0x6B
+#define REG_BANK_SEL      0x6D
+#define REG_MEM_START     0x6E
+#define REG_MEM_R_W       0x6F
+#define REG_FIFO_COUNTH   0x72
+#define REG_FIFO_COUNTL   0x73
+#define REG_FIFO_R_W      0x74
+#define REG_WHO_AM_I      0x75
+
+#define INT_DATA_RDY      0x01
+#define INT_DMP           0x02
+#define INT_FIFO_OFLOW    0x10
+
+#define FIFO_EN_TEMP      0x80
+#define FIFO_EN_XG        0x40
+#define FIFO_EN_YG        0x20
+#define FIFO_EN_ZG        0x10
+#define FIFO_EN_ACCEL     0x08
+
+#define USER_CTRL_DMP_EN     0x80
+#define USER_CTRL_FIFO_EN    0x40
+#define USER_CTRL_DMP_RESET  0x08
+#define USER_CTRL_FIFO_RESET 0x04
+#define USER_CTRL_RESETS     0x0F   // self-clearing
+
+#define PWR_DEVICE_RESET  0x80
+#define PWR_SLEEP         0x40
+
+// Memory location of the DMP output rate divider (dmpSetFIFORate())
+#define DMP_RATE_ADDRESS  (2 * 256 + 0x17)
+
+// DLPF group delay by DLPF_CFG, accelerometer and gyro, in us
+static const uint32_t accelDelayUs[8] = { 0, 2000, 3000, 4900, 8500, 13800, 19000, 0 };
+static const uint32_t gyroDelayUs[8] = { 980, 1900, 2800, 4800, 8300, 13400, 18600, 980 };
+
+/**
+ * @param clockPpm Error of the internal oscillator, positive samples slower
+ */
+I2CSimMPU6050::I2CSimMPU6050(int32_t clockPpm) : clockPpm(clockPpm), noise(0x1234567u + clockPpm) {
+  memset(memory, 0, sizeof(memory));
+  reset();
+}
+
+// Power-on state; the DMP memory survives a reset
+void I2CSimMPU6050::reset() {
+  memset(regs, 0, sizeof(regs));
+  regs[REG_PWR_MGMT_1] = PWR_SLEEP;
+  regs[REG_WHO_AM_I] = 0x68;
+  pointer = 0;
+  fifoHead = fifoCount = 0;
+  nextSample = 0;
+  dmpSamples = 0;
+}
+
+uint64_t I2CSimMPU6050::samplePeriod() {
+  uint8_t dlpf = regs[REG_CONFIG] & 0x07;
+  double rate = (dlpf == 0 || dlpf == 7 ? 8000.0 : 1000.0) / (1 + regs[REG_SMPLRT_DIV]);
+  return (uint64_t) (1e9 / rate * (1 + clockPpm * 1e-6));
+}
+
+// A few LSB of noise
+int16_t I2CSimMPU6050::dither() {
+  noise = noise * 1664525u + 1013904223u;
+  return (int16_t) ((noise >> 24) % 7) - 3;
+}
+
+static void putWord(uint8_t *p, int16_t value) {
+  p[0] = (uint16_t) value >> 8;
+  p[1] = value & 0xFF;
+}
+
+static void putLong(uint8_t *p, int32_t value) {
+  p[0] = (uint32_t) value >> 24;
+  p[1] = ((uint32_t) value >> 16) & 0xFF;
+  p[2] = ((uint32_t) value >> 8) & 0xFF;
+  p[3] = value & 0xFF;
+}
+
+static int16_t saturate(double value) {
+  return value > 32767 ? 32767 : value < -32768 ? -32768 : (int16_t) lrint(value);
+}
+
+// Take one sample due at time t
+void I2CSimMPU6050::sample(uint64_t t) {
+  uint8_t dlpf = regs[REG_CONFIG] & 0x07;
+  I2CSimMotion accelMotion, gyroMotion;
+  I2CSimTransport::motion((t - accelDelayUs[dlpf] * 1000ull) / 1e9, &accelMotion);
+  I2CSimTransport::motion((t - gyroDelayUs[dlpf] * 1000ull) / 1e9, &gyroMotion);
+
+  double accelLsb = 16384.0 / (1 << ((regs[REG_ACCEL_CONFIG] >> 3) & 0x03));
+  double gyroLsb = 131.0 / (1 << ((regs[REG_GYRO_CONFIG] >> 3) & 0x03)) * 180 / M_PI;
+  int16_t accel[3], gyro[3];
+  for (int i = 0; i < 3; i++) {
+    accel[i] = saturate(accelMotion.gravity[i] * accelLsb + dither());
+    gyro[i] = saturate(gyroMotion.rate[i] * gyroLsb + dither());
+  }
+  // 25 degC, TEMP_OUT / 340 + 36.53
+  int16_t temp = -3920 + dither();
+
+  uint8_t *data = &regs[REG_ACCEL_XOUT_H];
+  for (int i = 0; i < 3; i++) {
+    putWord(&data[2 * i], accel[i]);
+    putWord(&data[8 + 2 * i], gyro[i]);
+  }
+  putWord(&data[6], temp);
+  if (regs[REG_INT_ENABLE] & INT_DATA_RDY)
+    regs[REG_INT_STATUS] |= INT_DATA_RDY;
+
+  uint8_t userCtrl = regs[REG_USER_CTRL];
+  if (!(userCtrl & USER_CTRL_FIFO_EN))
+    return;
+  if (userCtrl & USER_CTRL_DMP_EN) {
+    if (++dmpSamples <= memory[DMP_RATE_ADDRESS])
+      return;
+    dmpSamples = 0;
+    // Q30 quaternion of the ZYX angles, 16-bit values in the upper half of each word
+    double hr = accelMotion.roll / 2, hp = accelMotion.pitch / 2, hy = accelMotion.yaw / 2;
+    double q[4] = {
+      cos(hr) * cos(hp) * cos(hy) + sin(hr) * sin(hp) * sin(hy),
+      sin(hr) * cos(hp) * cos(hy) - cos(hr) * sin(hp) * sin(hy),
+      cos(hr) * sin(hp) * cos(hy) + sin(hr) * cos(hp) * sin(hy),
+      cos(hr) * cos(hp) * sin(hy) - sin(hr) * sin(hp) * cos(hy),
+    };
+    uint8_t packet[I2C_SIM_MPU6050_PACKET_SIZE];
+    memset(packet, 0, sizeof(packet));
+    for (int i = 0; i < 4; i++)
+      putLong(&packet[4 * i], (int32_t) lrint(q[i] * 1073741824.0));
+    for (int i = 0; i < 3; i++) {
+      putLong(&packet[16 + 4 * i], (int32_t) ((uint32_t) (uint16_t) gyro[i] << 16));
+      putLong(&packet[28 + 4 * i], (int32_t) ((uint32_t) (uint16_t) accel[i] << 16));
+    }
+    fifoPush(packet, sizeof(packet));
+    if (regs[REG_INT_ENABLE] & INT_DMP)
+      regs[REG_INT_STATUS] |= INT_DMP;
+    return;
+  }
+
+  uint8_t fifoEn = regs[REG_FIFO_EN];
+  if (fifoEn & FIFO_EN_ACCEL)
+    fifoPush(&data[0], 6);
+  if (fifoEn & FIFO_EN_TEMP)
+    fifoPush(&data[6], 2);
+  if (fifoEn & FIFO_EN_XG)
+    fifoPush(&data[8], 2);
+  if (fifoEn & FIFO_EN_YG)
+    fifoPush(&data[10], 2);
+  if (fifoEn & FIFO_EN_ZG)
+    fifoPush(&data[12], 2);
+}
+
+// Append to the FIFO, overwriting the oldest bytes when it is full
+void I2CSimMPU6050::fifoPush(const uint8_t *data, uint16_t len) {
+  for (uint16_t i = 0; i < len; i++) {
+    if (fifoCount == I2C_SIM_MPU6050_FIFO_SIZE) {
+      fifoHead = (fifoHead + 1) % I2C_SIM_MPU6050_FIFO_SIZE;
+      fifoCount--;
+      if (regs[REG_INT_ENABLE] & INT_FIFO_OFLOW)
+        regs[REG_INT_STATUS] |= INT_FIFO_OFLOW;
+    }
+    fifo[(fifoHead + fifoCount) % I2C_SIM_MPU6050_FIFO_SIZE] = data[i];
+    fifoCount++;
+  }
+}
+
+// Take every sample that has come due up to now
+void I2CSimMPU6050::advance(uint64_t nowNs) {
+  if (regs[REG_PWR_MGMT_1] & PWR_SLEEP) {
+    nextSample = 0;
+    return;
+  }
+  uint64_t period = samplePeriod();
+  if (nextSample == 0)
+    nextSample = nowNs + period;
+  if (nowNs >= nextSample + I2C_SIM_MPU6050_MAX_CATCHUP * period) {
+    // Idle for long: the FIFO would have overflowed many times over
+    nextSample += ((nowNs - nextSample) / period - I2C_SIM_MPU6050_MAX_CATCHUP) * period;
+    if ((regs[REG_USER_CTRL] & USER_CTRL_FIFO_EN) && (regs[REG_INT_ENABLE] & INT_FIFO_OFLOW))
+      regs[REG_INT_STATUS] |= INT_FIFO_OFLOW;
+  }
+  while (nextSample <= nowNs) {
+    sample(nextSample);
+    nextSample += period;
+  }
+}
+
+// Register read with its side effects
+uint8_t I2CSimMPU6050::readRegister(uint8_t reg) {
+  uint8_t value;
+  switch (reg) {
+    case REG_INT_STATUS:
+      value = regs[reg];
+      regs[reg] = 0;
+      return value;
+    case REG_FIFO_COUNTH:
+      return fifoCount >> 8;
+    case REG_FIFO_COUNTL:
+      return fifoCount & 0xFF;
+    case REG_FIFO_R_W:
+      if (fifoCount == 0)
+        return 0;
+      value = fifo[fifoHead];
+      fifoHead = (fifoHead + 1) % I2C_SIM_MPU6050_FIFO_SIZE;
+      fifoCount--;
+      return value;
+    case REG_MEM_R_W:
+      value = memory[(regs[REG_BANK_SEL] & 0x1F) * 256 + regs[REG_MEM_START]];
+      regs[REG_MEM_START]++;
+      return value;
+    default:
+      return regs[reg & 0x7F];
+  }
+}
+
+void I2CSimMPU6050::writeRegister(uint8_t reg, uint8_t value, uint64_t nowNs) {
+  if ((reg >= REG_INT_STATUS && reg <= REG_DATA_END) ||
+      (reg >= REG_FIFO_COUNTH && reg <= REG_WHO_AM_I))
+    return;
+  switch (reg) {
+    case REG_MEM_R_W:
+      memory[(regs[REG_BANK_SEL] & 0x1F) * 256 + regs[REG_MEM_START]] = value;
+      regs[REG_MEM_START]++;
+      return;
+    case REG_PWR_MGMT_1:
+      if (value & PWR_DEVICE_RESET) {
+        reset();
+        return;
+      }
+      regs[reg] = value;
+      if (value & PWR_SLEEP)
+        nextSample = 0;
+      else if (nextSample == 0)
+        nextSample = nowNs + samplePeriod();
+      return;
+    case REG_USER_CTRL:
+      if (value & USER_CTRL_FIFO_RESET)
+        fifoHead = fifoCount = 0;
+      if (value & USER_CTRL_DMP_RESET)
+        dmpSamples = 0;
+      regs[reg] = value & ~USER_CTRL_RESETS;
+      return;
+    default:
+      regs[reg] = value;
+  }
+}
+
+/** Register write: the register address, then data for it and the following ones.
+ */
+bool I2CSimMPU6050::write(const uint8_t *data, uint16_t len, uint64_t nowNs) {
+  advance(nowNs);
+  if (len == 0)
+    return true;
+  pointer = data[0] & 0x7F;
+  for (uint16_t i = 1; i < len; i++) {
+    writeRegister(pointer, data[i], nowNs);
+    if (pointer != REG_FIFO_R_W && pointer != REG_MEM_R_W)
+      pointer = (pointer + 1) & 0x7F;
+  }
+  return true;
+}
+
+/** Burst read from the register address set by the last write.
+ */
+bool I2CSimMPU6050::read(uint8_t *data, uint16_t len, uint64_t nowNs) {
+  advance(nowNs);
+  for (uint16_t i = 0; i < len; i++) {
+    data[i] = readRegister(pointer);
+    if (pointer != REG_FIFO_R_W && pointer != REG_MEM_R_W)
+      pointer = (pointer + 1) & 0x7F;
+  }
+  return true;
+}
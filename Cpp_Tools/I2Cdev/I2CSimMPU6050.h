@@ -0,0 +1,64 @@
+/* I2Cdev library collection - Simulated MPU6050
+   Register-level model of the parts of the MPU6050 the drivers use:
+
+   - The register file with its reset values, burst access with address
+     auto-increment (FIFO_R_W and MEM_R_W stay put), read-only data and
+     status registers and the self-clearing reset bits.
+   - Sampling at the gyro rate (8 kHz with the DLPF off, else 1 kHz)
+     divided by 1 + SMPLRT_DIV, on an oscillator that is off by a set
+     number of ppm. Nothing is sampled while SLEEP is set.
+   - The DLPF group delay of the selected bandwidth: each sample shows the
+     motion as it was that long ago. The filtering itself is not modelled.
+   - DATA_RDY, DMP_INT and FIFO_OFLOW in INT_STATUS, cleared by reading it.
+     The INT pin has no counterpart, so GPIO interrupt mode needs hardware.
+   - The 1024 byte FIFO, filled in register order with what FIFO_EN selects,
+     dropping its oldest bytes on overflow.
+   - The DMP memory banks, so a firmware upload verifies. With DMP_EN set
+     the FIFO receives 42 byte packets (quaternion, gyro, accel) at the
+     sample rate divided by the rate the firmware configuration wrote, but
+     the firmware itself is not run.
+
+   The state is brought up to date whenever the device is addressed, so an
+   idle device costs nothing.
+*/
+
+#ifndef _I2CSIMMPU6050_H_
+#define _I2CSIMMPU6050_H_
+
+#include "I2CSimTransport.h"
+
+#define I2C_SIM_MPU6050_FIFO_SIZE 1024
+#define I2C_SIM_MPU6050_MEMORY_BANKS 32
+#define I2C_SIM_MPU6050_PACKET_SIZE 42
+// Samples generated at most when catching up after a long idle time
+#define I2C_SIM_MPU6050_MAX_CATCHUP 2048
+
+class I2CSimMPU6050 : public I2CSimDevice {
+ public:
+    I2CSimMPU6050(int32_t clockPpm);
+
+    bool write(const uint8_t *data, uint16_t len, uint64_t nowNs);
+    bool read(uint8_t *data, uint16_t len, uint64_t nowNs);
+
+ private:
+    uint8_t regs[128];
+    uint8_t pointer;
+    uint8_t fifo[I2C_SIM_MPU6050_FIFO_SIZE];
+    uint16_t fifoHead, fifoCount;
+    uint8_t memory[I2C_SIM_MPU6050_MEMORY_BANKS * 256];
+    int32_t clockPpm;
+    uint64_t nextSample;    // 0 while asleep
+    uint32_t dmpSamples;    // samples since the last DMP packet
+    uint32_t noise;
+
+    void reset();
+    void advance(uint64_t nowNs);
+    uint64_t samplePeriod();
+    void sample(uint64_t t);
+    void fifoPush(const uint8_t *data, uint16_t len);
+    uint8_t readRegister(uint8_t reg);
+    void writeRegister(uint8_t reg, uint8_t value, uint64_t nowNs);
+    int16_t dither();
+};
+
+#endif /* _I2CSIMMPU6050_H_ */
@@ -0,0 +1,150 @@
+// I2Cdev library collection - Simulated I2C bus
+
+#include "I2CSimTransport.h"
+#include "I2CSimMPU6050.h"
+#include "I2CSimHMC6343.h"
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <time.h>
+
+// Earth field the simulated compass senses, gauss (north and down)
+#define SIM_FIELD_NORTH 0.20
+#define SIM_FIELD_DOWN  0.45
+
+/** Create the bus with the default devices.
+ * @param clockHz Bus clock, 0 for the rate passed to begin()
+ */
+I2CSimTransport::I2CSimTransport(uint32_t clockHz) : clockHz(clockHz), busFree(0) {
+  memset(devices, 0, sizeof(devices));
+  pthread_mutex_init(&lock, NULL);
+  // The two IMUs run off oscillators that are off in opposite directions
+  attach(0x68, new I2CSimMPU6050(150));
+  attach(0x69, new I2CSimMPU6050(-80));
+  attach(0x19, new I2CSimHMC6343());
+}
+
+I2CSimTransport::~I2CSimTransport() {
+  for (int i = 0; i < 128; i++)
+    delete devices[i];
+  pthread_mutex_destroy(&lock);
+}
+
+bool I2CSimTransport::begin(uint32_t baudrate) {
+  if (clockHz == 0)
+    clockHz = baudrate;
+  return clockHz > 0;
+}
+
+void I2CSimTransport::end() { }
+
+/** Put a device model on the bus, replacing any at that address.
+ * @param device Model, owned by the bus from now on
+ */
+void I2CSimTransport::attach(uint8_t addr, I2CSimDevice *device) {
+  addr &= 0x7F;
+  delete devices[addr];
+  devices[addr] = device;
+}
+
+I2CSimDevice *I2CSimTransport::getDevice(uint8_t addr) {
+  return devices[addr & 0x7F];
+}
+
+uint32_t I2CSimTransport::getClock() {
+  return clockHz;
+}
+
+/** Current CLOCK_MONOTONIC time, the clock the models run on.
+ * @return Nanoseconds
+ */
+uint64_t I2CSimTransport::now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/** The shared synthetic motion.
+ * @param t Time in seconds
+ */
+void I2CSimTransport::motion(double t, I2CSimMotion *m) {
+  const double rollAmp = 0.2, rollW = 2 * M_PI * 0.25;
+  const double pitchAmp = 0.1, pitchW = 2 * M_PI * 0.1;
+  const double yawRate = 2 * M_PI / 60;
+  m->roll = rollAmp * sin(rollW * t);
+  m->pitch = pitchAmp * sin(pitchW * t);
+  m->yaw = fmod(yawRate * t, 2 * M_PI);
+  double rollDot = rollAmp * rollW * cos(rollW * t);
+  double pitchDot = pitchAmp * pitchW * cos(pitchW * t);
+
+  double sr = sin(m->roll), cr = cos(m->roll);
+  double sp = sin(m->pitch), cp = cos(m->pitch);
+  double sy = sin(m->yaw), cy = cos(m->yaw);
+  m->rate[0] = rollDot - sp * yawRate;
+  m->rate[1] = cr * pitchDot + sr * cp * yawRate;
+  m->rate[2] = -sr * pitchDot + cr * cp * yawRate;
+  m->gravity[0] = -sp;
+  m->gravity[1] = sr * cp;
+  m->gravity[2] = cr * cp;
+
+  // Rotate the north/down field into the body frame (transpose of the ZYX DCM)
+  double n[3] = { SIM_FIELD_NORTH * cy, -SIM_FIELD_NORTH * sy, SIM_FIELD_DOWN };
+  m->field[0] = cp * n[0] - sp * n[2];
+  m->field[1] = sr * sp * n[0] + cr * n[1] + sr * cp * n[2];
+  m->field[2] = cr * sp * n[0] - sr * n[1] + cr * cp * n[2];
+}
+
+// Duration of a number of bus clocks
+uint64_t I2CSimTransport::bits(uint32_t count) {
+  return (uint64_t) count * 1000000000ull / clockHz;
+}
+
+void I2CSimTransport::waitUntil(uint64_t ns) {
+  if (ns > now() + I2C_SIM_SPIN_NS) {
+    uint64_t wake = ns - I2C_SIM_SPIN_NS;
+    struct timespec ts;
+    ts.tv_sec = wake / 1000000000ull;
+    ts.tv_nsec = wake % 1000000000ull;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+      ;
+  }
+  while (now() < ns)
+    ;
+}
+
+/** Run the messages through the device models with bus timing.
+ * @return I2C_REASON_ERROR_NACK if a message was refused, else I2C_REASON_OK
+ */
+uint8_t I2CSimTransport::transfer(I2CMessage *msgs, uint8_t count) {
+  if (clockHz == 0 || count > I2C_TRANSFER_MAX_MSGS)
+    return I2C_REASON_ERROR_IO;
+  pthread_mutex_lock(&lock);
+  uint64_t start = now();
+  if (start < busFree)
+    start = busFree;
+  uint64_t t = start + I2C_SIM_TRANSFER_OVERHEAD_NS;
+  uint8_t response = I2C_REASON_OK;
+  for (uint8_t i = 0; i < count; i++) {
+    I2CSimDevice *device = devices[msgs[i].addr & 0x7F];
+    // (repeated) start and address byte
+    t += bits(1 + 9);
+    if (device == NULL) {
+      response = I2C_REASON_ERROR_NACK;
+      break;
+    }
+    t += bits(9 * msgs[i].len);
+    bool ack = (msgs[i].flags & I2C_MSG_READ) ? device->read(msgs[i].buf, msgs[i].len, t)
+                                              : device->write(msgs[i].buf, msgs[i].len, t);
+    if (!ack) {
+      // Refused at the address byte, the data never went over the bus
+      t -= bits(9 * msgs[i].len);
+      response = I2C_REASON_ERROR_NACK;
+      break;
+    }
+  }
+  t += bits(1);     // stop
+  busFree = t;
+  waitUntil(t);
+  pthread_mutex_unlock(&lock);
+  return response;
+}
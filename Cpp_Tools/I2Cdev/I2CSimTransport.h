@@ -0,0 +1,81 @@
+/* I2Cdev library collection - Simulated I2C bus
+   Runs the tools without a Pi or sensors: I2CDEV_BUS=sim puts an MPU6050 at
+   0x68, a second one at 0x69 and an HMC6343 at 0x19 on a simulated bus, so
+   the readers, the daemon and the calibration tools run unmodified on a
+   desktop and their throughput and timing can be measured.
+
+   Transfers take as long as on a real bus: every message costs a (repeated)
+   start, the address byte and its data bytes at 9 clocks each, the transfer
+   a stop and a fixed software overhead. The clock is the rate I2Cdev asks
+   for (400 kHz) or the one given as "sim:100000" / "sim:100k". The bus is
+   held for the whole transfer and the caller returns when it would have
+   completed. A message to an address without a device, or one the device
+   refuses (e.g. an HMC6343 answer read before its response time), is
+   NACKed after the address byte.
+
+   The device models see each message at the time it completes on the
+   bus, and both sense the same synthetic motion (I2CSimMotion), so their
+   outputs agree with each other.
+*/
+
+#ifndef _I2CSIMTRANSPORT_H_
+#define _I2CSIMTRANSPORT_H_
+
+#include <stdint.h>
+#include <pthread.h>
+#include "I2CTransport.h"
+
+// Per-transfer software cost on top of the bus clocks (driver and syscall)
+#define I2C_SIM_TRANSFER_OVERHEAD_NS 15000
+// Transfers ending sooner than this are waited out spinning instead of sleeping
+#define I2C_SIM_SPIN_NS 100000
+
+/** A device model on the simulated bus. Each call is one message addressed
+ * to it, completing at nowNs (CLOCK_MONOTONIC); returning false NACKs it.
+ */
+class I2CSimDevice {
+ public:
+    virtual ~I2CSimDevice() { }
+
+    virtual bool write(const uint8_t *data, uint16_t len, uint64_t nowNs) = 0;
+    virtual bool read(uint8_t *data, uint16_t len, uint64_t nowNs) = 0;
+};
+
+/** Synthetic motion sensed by every model: a slow turn (one revolution a
+ * minute) with a gentle roll and pitch sway, in the earth's magnetic field.
+ */
+typedef struct i2c_sim_motion {
+    double roll, pitch, yaw;    // rad, ZYX Euler angles
+    double rate[3];             // body angular rate, rad/s
+    double gravity[3];          // specific force in g, +Z is up when level
+    double field[3];            // magnetic field in the body frame, gauss
+} I2CSimMotion;
+
+class I2CSimTransport : public I2CTransport {
+ public:
+    I2CSimTransport(uint32_t clockHz);
+    ~I2CSimTransport();
+
+    bool begin(uint32_t baudrate);
+    void end();
+    uint8_t transfer(I2CMessage *msgs, uint8_t count);
+    const char *name() const { return "sim"; }
+
+    void attach(uint8_t addr, I2CSimDevice *device);
+    I2CSimDevice *getDevice(uint8_t addr);
+    uint32_t getClock();
+
+    static uint64_t now();
+    static void motion(double t, I2CSimMotion *m);
+
+ private:
+    I2CSimDevice *devices[128];
+    uint32_t clockHz;       // 0 until begin() when not given
+    uint64_t busFree;       // end of the last transfer
+    pthread_mutex_t lock;
+
+    uint64_t bits(uint32_t count);
+    void waitUntil(uint64_t ns);
+};
+
+#endif /* _I2CSIMTRANSPORT_H_ */
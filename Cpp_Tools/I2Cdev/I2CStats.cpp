@@ -0,0 +1,276 @@
+// I2Cdev library collection - Bus transaction statistics
+
+#include "I2CStats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <new>
+
+#define KEY_VALID    0x80000000u
+#define KEY_OVERFLOW 0x40000000u
+#define KEY_READ     0x00010000u
+#define KEY_ANSWER   0x00020000u
+#define KEY_BUS_SHIFT 18
+
+std::atomic<I2CStats::Table *> I2CStats::tables(NULL);
+thread_local I2CStats::Table *I2CStats::local = NULL;
+const char *I2CStats::busNames[I2C_STATS_BUSES];
+std::atomic<uint8_t> I2CStats::buses(0);
+pthread_mutex_t I2CStats::busLock = PTHREAD_MUTEX_INITIALIZER;
+static std::atomic<uint64_t> startNs(0);
+
+// Summed counters of one key, for print()
+typedef struct total {
+  uint32_t key;
+  uint64_t transactions;
+  uint64_t failures[I2C_STATS_REASONS];
+  uint64_t bytes;
+  uint64_t busyNs;
+  uint64_t maxNs;
+  uint64_t buckets[I2C_STATS_BUCKETS];
+} Total;
+
+/** Current CLOCK_MONOTONIC time, used to time the transfers.
+ * @return Nanoseconds
+ */
+uint64_t I2CStats::now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/** Number a bus for its transfers to be counted apart from other buses'.
+ * Called when a bus is opened; a name seen before gets its number again.
+ * @param name Bus name, e.g. the transport's
+ * @return Bus number for record()
+ */
+uint8_t I2CStats::registerBus(const char *name) {
+  pthread_mutex_lock(&busLock);
+  uint8_t count = buses.load(std::memory_order_relaxed);
+  uint8_t bus = 0;
+  while (bus < count && strcmp(busNames[bus], name) != 0)
+    bus++;
+  if (bus == count) {
+    if (count < I2C_STATS_BUSES) {
+      busNames[bus] = strdup(name);
+      buses.store(count + 1, std::memory_order_release);
+    } else {
+      bus = I2C_STATS_BUSES - 1;
+    }
+  }
+  pthread_mutex_unlock(&busLock);
+  return bus;
+}
+
+// Counters are only written by the owning thread, so a relaxed load and store is enough
+template <typename T> static inline void add(std::atomic<T> &counter, T value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+// The calling thread's table, created and published on first use
+I2CStats::Table *I2CStats::localTable() {
+  if (local)
+    return local;
+  Table *table = new (std::nothrow) Table();
+  if (table == NULL)
+    return NULL;
+  uint64_t expected = 0;
+  startNs.compare_exchange_strong(expected, now());
+  table->next = tables.load(std::memory_order_relaxed);
+  while (!tables.compare_exchange_weak(table->next, table, std::memory_order_release))
+    ;
+  local = table;
+  return table;
+}
+
+// Bytes on the wire for a message, address byte included
+static inline uint32_t wireBytes(const I2CMessage *msg) {
+  return 1 + msg->len;
+}
+
+// Messages making up the next operation of a transfer: a register write and
+// the read of its answer, or a single message
+static inline uint8_t operationLength(const I2CMessage *msgs, uint8_t count) {
+  return count > 1 && !(msgs[0].flags & I2C_MSG_READ) && msgs[0].len > 0 &&
+         (msgs[1].flags & I2C_MSG_READ) && msgs[1].addr == msgs[0].addr ? 2 : 1;
+}
+
+/** Count one transfer. A combined transfer of several operations, e.g. an
+ * I2CBatch reading several devices, is counted per operation under its own
+ * device and register, with the time shared out by bytes on the wire. The
+ * transport's status is that of the whole transfer and counts against each.
+ * @param bus Bus number from registerBus()
+ * @param msgs Messages of the transfer, as passed to I2CTransport::transfer()
+ * @param count Number of messages
+ * @param reason I2C_REASON_* returned by the transport
+ * @param ns Time the transfer took
+ */
+void I2CStats::record(uint8_t bus, const I2CMessage *msgs, uint8_t count, uint8_t reason, uint64_t ns) {
+  Table *table = localTable();
+  if (table == NULL || count == 0)
+    return;
+  bus &= I2C_STATS_BUSES - 1;
+  if (operationLength(msgs, count) == count) {
+    recordOperation(table, bus, msgs, count, reason, ns);
+    return;
+  }
+
+  uint64_t total = 0;
+  for (uint8_t i = 0; i < count; i++)
+    total += wireBytes(&msgs[i]);
+  uint64_t remaining = ns;
+  for (uint8_t i = 0; i < count; ) {
+    uint8_t n = operationLength(msgs + i, count - i);
+    uint64_t share = remaining;
+    if (i + n < count) {
+      share = 0;
+      for (uint8_t j = i; j < i + n; j++)
+        share += wireBytes(&msgs[j]);
+      share = share * ns / total;
+    }
+    recordOperation(table, bus, msgs + i, n, reason, share);
+    remaining -= share;
+    i += n;
+  }
+}
+
+// Count one operation of a transfer
+void I2CStats::recordOperation(Table *table, uint8_t bus, const I2CMessage *msgs, uint8_t count,
+                               uint8_t reason, uint64_t ns) {
+  // Key on bus, address, register and direction
+  uint8_t addr = msgs[0].addr & 0x7F;
+  uint32_t key = KEY_VALID | (uint32_t) bus << KEY_BUS_SHIFT | (uint32_t) addr << 8;
+  if (!(msgs[0].flags & I2C_MSG_READ) && msgs[0].len > 0) {
+    table->lastRegister[bus][addr] = msgs[0].buf[0];
+    key |= msgs[0].buf[0];
+    if (count > 1 && (msgs[1].flags & I2C_MSG_READ))
+      key |= KEY_READ;
+  } else {
+    key |= KEY_READ | KEY_ANSWER | table->lastRegister[bus][addr];
+  }
+
+  I2CStatsEntry *entry = &table->entries[I2C_STATS_ENTRIES];
+  uint32_t slot = (key * 2654435761u) >> 26;
+  for (int probe = 0; probe < I2C_STATS_ENTRIES; probe++) {
+    I2CStatsEntry *candidate = &table->entries[(slot + probe) % I2C_STATS_ENTRIES];
+    uint32_t found = candidate->key.load(std::memory_order_relaxed);
+    if (found == key) {
+      entry = candidate;
+      break;
+    }
+    if (found == 0) {
+      candidate->key.store(key, std::memory_order_release);
+      entry = candidate;
+      break;
+    }
+  }
+  if (entry == &table->entries[I2C_STATS_ENTRIES] && entry->key.load(std::memory_order_relaxed) == 0)
+    entry->key.store(KEY_VALID | KEY_OVERFLOW, std::memory_order_release);
+
+  uint64_t bytes = 0;
+  for (uint8_t i = 0; i < count; i++)
+    bytes += msgs[i].len;
+  add(entry->transactions, 1u);
+  add(entry->bytes, bytes);
+  add(entry->busyNs, ns);
+  if (ns > entry->maxNs.load(std::memory_order_relaxed))
+    entry->maxNs.store(ns, std::memory_order_relaxed);
+  for (int i = 0; i < I2C_STATS_REASONS; i++) {
+    if (reason & (1 << i))
+      add(entry->failures[i], 1u);
+  }
+  uint64_t us = ns / 1000;
+  int bucket = us ? 64 - __builtin_clzll(us) : 0;
+  add(entry->buckets[bucket < I2C_STATS_BUCKETS ? bucket : I2C_STATS_BUCKETS - 1], 1u);
+}
+
+static int compareBusy(const void *a, const void *b) {
+  uint64_t busyA = ((const Total *) a)->busyNs, busyB = ((const Total *) b)->busyNs;
+  return busyA < busyB ? 1 : busyA > busyB ? -1 : 0;
+}
+
+/** Print the counters of all threads added up, one entry per bus, device
+ * address, register and direction, the busiest first.
+ */
+void I2CStats::print(FILE *out) {
+  int capacity = 0;
+  for (Table *table = tables.load(std::memory_order_acquire); table; table = table->next)
+    capacity += I2C_STATS_ENTRIES + 1;
+  if (capacity == 0) {
+    fprintf(out, "I2C: no transfers\n");
+    return;
+  }
+  Total *totals = (Total *) calloc(capacity, sizeof(Total));
+  if (totals == NULL)
+    return;
+
+  int used = 0;
+  for (Table *table = tables.load(std::memory_order_acquire); table; table = table->next) {
+    for (int i = 0; i <= I2C_STATS_ENTRIES; i++) {
+      const I2CStatsEntry *entry = &table->entries[i];
+      uint32_t key = entry->key.load(std::memory_order_acquire);
+      if (key == 0)
+        continue;
+      Total *total = totals;
+      while (total < totals + used && total->key != key)
+        total++;
+      if (total == totals + used) {
+        total->key = key;
+        used++;
+      }
+      total->transactions += entry->transactions.load(std::memory_order_relaxed);
+      total->bytes += entry->bytes.load(std::memory_order_relaxed);
+      total->busyNs += entry->busyNs.load(std::memory_order_relaxed);
+      uint64_t max = entry->maxNs.load(std::memory_order_relaxed);
+      if (max > total->maxNs)
+        total->maxNs = max;
+      for (int j = 0; j < I2C_STATS_REASONS; j++)
+        total->failures[j] += entry->failures[j].load(std::memory_order_relaxed);
+      for (int j = 0; j < I2C_STATS_BUCKETS; j++)
+        total->buckets[j] += entry->buckets[j].load(std::memory_order_relaxed);
+    }
+  }
+  qsort(totals, used, sizeof(Total), compareBusy);
+
+  double elapsed = (double) (now() - startNs.load(std::memory_order_relaxed));
+  // Each bus runs on its own, so the busy time is a share of the elapsed time per bus
+  uint64_t busy[I2C_STATS_BUSES + 1] = { 0 };     // the last one for overflow
+  uint8_t registered = buses.load(std::memory_order_acquire);
+  for (int i = 0; i < used; i++) {
+    if (totals[i].key & KEY_OVERFLOW)
+      busy[I2C_STATS_BUSES] += totals[i].busyNs;
+    else
+      busy[(totals[i].key >> KEY_BUS_SHIFT) & (I2C_STATS_BUSES - 1)] += totals[i].busyNs;
+  }
+  for (int bus = 0; bus <= I2C_STATS_BUSES; bus++) {
+    if (busy[bus] == 0)
+      continue;
+    fprintf(out, "I2C: %s busy %0.1f%% of %0.1f s\n",
+            bus == I2C_STATS_BUSES ? "(other)" : bus < registered ? busNames[bus] : "?",
+            elapsed > 0 ? busy[bus] / elapsed * 100 : 0.0, elapsed / 1e9);
+  }
+  for (int i = 0; i < used; i++) {
+    const Total *total = &totals[i];
+    if (total->key & KEY_OVERFLOW) {
+      fprintf(out, "  (other)        ");
+    } else {
+      uint8_t bus = (total->key >> KEY_BUS_SHIFT) & (I2C_STATS_BUSES - 1);
+      fprintf(out, "  %s 0x%02X reg 0x%02X %-6s", bus < registered ? busNames[bus] : "?",
+              (total->key >> 8) & 0x7F, total->key & 0xFF,
+              total->key & KEY_ANSWER ? "answer" : total->key & KEY_READ ? "read" : "write");
+    }
+    fprintf(out, " %llu transfers, %llu bytes, busy %0.1f%%, mean %0.1f us, max %0.1f us, "
+            "failures nack %llu clkt %llu data %llu io %llu\n   ",
+            (unsigned long long) total->transactions, (unsigned long long) total->bytes,
+            elapsed > 0 ? total->busyNs / elapsed * 100 : 0.0,
+            total->transactions ? total->busyNs / 1e3 / total->transactions : 0.0, total->maxNs / 1e3,
+            (unsigned long long) total->failures[0], (unsigned long long) total->failures[1],
+            (unsigned long long) total->failures[2], (unsigned long long) total->failures[3]);
+    for (int j = 0; j < I2C_STATS_BUCKETS; j++) {
+      if (total->buckets[j])
+        fprintf(out, " <%lluus:%llu", 1ull << j, (unsigned long long) total->buckets[j]);
+    }
+    fprintf(out, "\n");
+  }
+  free(totals);
+}
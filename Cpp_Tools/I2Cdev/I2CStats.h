@@ -0,0 +1,71 @@
+/* I2Cdev library collection - Bus transaction statistics
+   Every transfer I2Cdev puts on the bus is timed and counted against its
+   bus, device address, register and direction: transactions, bytes, busy time,
+   failures by reason (NACK, clock stretch timeout, data loss, I/O error)
+   and a latency histogram in power-of-two microsecond buckets. A bare read
+   without a register byte, such as an HMC6343 answer, is counted against
+   the last register or command the same thread wrote to that device, and
+   a combined transfer across devices is split into its register reads.
+
+   Each thread counts into a table of its own, so recording is two clock
+   reads and a few relaxed atomic stores with no shared cache lines or locks.
+   The tables live as long as the process; print() adds them up across all
+   threads and can run at any time, e.g. from a SIGUSR1 request or at exit.
+   A thread's table holds I2C_STATS_ENTRIES keys, any further ones are
+   counted in one overflow entry. Buses are told apart by name, the first
+   I2C_STATS_BUSES distinct ones; further buses share the last number.
+*/
+
+#ifndef _I2CSTATS_H_
+#define _I2CSTATS_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <atomic>
+#include "I2CTransport.h"
+
+#define I2C_STATS_ENTRIES 64
+// Bucket i counts transfers below 2^i us, the last one everything longer
+#define I2C_STATS_BUCKETS 16
+// Failure reasons counted, in the bit order of I2C_REASON_ERROR_*
+#define I2C_STATS_REASONS 4
+// Buses counted separately, a power of two
+#define I2C_STATS_BUSES 16
+
+typedef struct i2c_stats_entry {
+    std::atomic<uint32_t> key;      // 0 while unused, see I2CStats::key()
+    std::atomic<uint32_t> transactions;
+    std::atomic<uint32_t> failures[I2C_STATS_REASONS];
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> busyNs;
+    std::atomic<uint64_t> maxNs;
+    std::atomic<uint32_t> buckets[I2C_STATS_BUCKETS];
+} I2CStatsEntry;
+
+class I2CStats {
+ public:
+    static uint64_t now();
+    static uint8_t registerBus(const char *name);
+    static void record(uint8_t bus, const I2CMessage *msgs, uint8_t count, uint8_t reason, uint64_t ns);
+    static void print(FILE *out);
+
+ private:
+    typedef struct table {
+        I2CStatsEntry entries[I2C_STATS_ENTRIES + 1];   // the last one collects overflow
+        uint8_t lastRegister[I2C_STATS_BUSES][128];     // per bus and address, for bare reads
+        struct table *next;
+    } Table;
+
+    static const char *busNames[I2C_STATS_BUSES];
+    static std::atomic<uint8_t> buses;
+    static pthread_mutex_t busLock;
+
+    static std::atomic<Table *> tables;
+    static thread_local Table *local;
+    static Table *localTable();
+    static void recordOperation(Table *table, uint8_t bus, const I2CMessage *msgs, uint8_t count,
+                                uint8_t reason, uint64_t ns);
+};
+
+#endif /* _I2CSTATS_H_ */
@@ -0,0 +1,233 @@
+// I2Cdev library collection - I2C transport backends
+// bcm2835 peripheral and Linux i2c-dev implementations of I2CTransport.
+
+#include "I2CTransport.h"
+#include "I2CSimTransport.h"
+#include <bcm2835.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+/** Create a transport for the named bus.
+ * @param bus NULL, "" or "bcm2835" for the Pi peripheral, a bus number such as
+ *            "1" for /dev/i2c-1, the full path of an i2c-dev node, or "sim" for
+ *            the simulated devices, optionally with a clock ("sim:100000", "sim:100k")
+ * @return New transport (not yet started), owned by the caller
+ */
+I2CTransport *I2CTransport::create(const char *bus) {
+  if (bus == NULL || bus[0] == '\0' || strcmp(bus, "bcm2835") == 0)
+    return new BCM2835Transport();
+  if (strncmp(bus, "sim", 3) == 0 && (bus[3] == '\0' || bus[3] == ':')) {
+    char *end;
+    unsigned long clock = bus[3] ? strtoul(bus + 4, &end, 10) : 0;
+    if (bus[3] && (*end == 'k' || *end == 'K'))
+      clock *= 1000;
+    return new I2CSimTransport(clock);
+  }
+
+  char device[64];
+  const char *p = bus;
+  while (isdigit((unsigned char) *p)) p++;
+  if (*p == '\0') {
+    snprintf(device, sizeof(device), "/dev/i2c-%s", bus);
+    return new LinuxI2CTransport(device);
+  }
+  return new LinuxI2CTransport(bus);
+}
+
+// ======== bcm2835 ========
+
+BCM2835Transport::BCM2835Transport() : slaveAddr(-1) { }
+
+bool BCM2835Transport::begin(uint32_t baudrate) {
+  if (!bcm2835_init())
+    return false;
+  bcm2835_i2c_set_baudrate(baudrate);
+  slaveAddr = -1;
+  return true;
+}
+
+void BCM2835Transport::end() {
+  bcm2835_close();
+}
+
+void BCM2835Transport::selectSlave(uint8_t addr) {
+  if (slaveAddr != addr) {
+    bcm2835_i2c_setSlaveAddress(addr);
+    slaveAddr = addr;
+  }
+}
+
+/** Execute a list of messages on the BSC peripheral.
+ * A write immediately followed by a read from the same slave is issued with a
+ * repeated start; any other message is sent as its own transaction.
+ * @return I2C_REASON_* status of the first failing message, or I2C_REASON_OK
+ */
+uint8_t BCM2835Transport::transfer(I2CMessage *msgs, uint8_t count) {
+  uint8_t response = I2C_REASON_OK;
+  for (uint8_t i = 0; i < count && response == I2C_REASON_OK; i++) {
+    selectSlave(msgs[i].addr);
+    if (!(msgs[i].flags & I2C_MSG_READ) && i + 1 < count &&
+        (msgs[i+1].flags & I2C_MSG_READ) && msgs[i+1].addr == msgs[i].addr) {
+      response = bcm2835_i2c_write_read_rs((char *) msgs[i].buf, msgs[i].len,
+                                           (char *) msgs[i+1].buf, msgs[i+1].len);
+      i++;
+    } else if (msgs[i].flags & I2C_MSG_READ) {
+      response = bcm2835_i2c_read((char *) msgs[i].buf, msgs[i].len);
+    } else {
+      response = bcm2835_i2c_write((const char *) msgs[i].buf, msgs[i].len);
+    }
+  }
+  return response;
+}
+
+// ======== Linux i2c-dev ========
+
+LinuxI2CTransport::LinuxI2CTransport(const char *device) : fd(-1), smbusOnly(false), slaveAddr(-1) {
+  snprintf(this->device, sizeof(this->device), "%s", device);
+}
+
+LinuxI2CTransport::~LinuxI2CTransport() {
+  end();
+}
+
+bool LinuxI2CTransport::begin(uint32_t baudrate) {
+  (void) baudrate;
+  if (fd >= 0)
+    return true;
+  fd = open(device, O_RDWR | O_CLOEXEC);
+  if (fd < 0) {
+    fprintf(stderr, "Could not open %s: %s\n", device, strerror(errno));
+    return false;
+  }
+  unsigned long funcs = 0;
+  if (ioctl(fd, I2C_FUNCS, &funcs) < 0) {
+    fprintf(stderr, "Could not query %s: %s\n", device, strerror(errno));
+    end();
+    return false;
+  }
+  // SMBus-only adapters (e.g. i2c-stub) get register transfers emulated with
+  // I2C block commands instead of raw messages
+  smbusOnly = !(funcs & I2C_FUNC_I2C);
+  if (smbusOnly && (funcs & I2C_FUNC_SMBUS_I2C_BLOCK) != I2C_FUNC_SMBUS_I2C_BLOCK) {
+    fprintf(stderr, "%s supports neither I2C transfers nor I2C block commands\n", device);
+    end();
+    return false;
+  }
+  slaveAddr = -1;
+  return true;
+}
+
+void LinuxI2CTransport::end() {
+  if (fd >= 0) {
+    close(fd);
+    fd = -1;
+  }
+}
+
+/** Execute a list of messages as a single I2C_RDWR ioctl.
+ * @return I2C_REASON_* status mapped from errno, or I2C_REASON_OK
+ */
+uint8_t LinuxI2CTransport::transfer(I2CMessage *msgs, uint8_t count) {
+  if (fd < 0 || count > I2C_TRANSFER_MAX_MSGS)
+    return I2C_REASON_ERROR_IO;
+  if (smbusOnly)
+    return smbusTransfer(msgs, count);
+
+  struct i2c_msg kmsgs[I2C_TRANSFER_MAX_MSGS];
+  for (uint8_t i = 0; i < count; i++) {
+    kmsgs[i].addr = msgs[i].addr;
+    kmsgs[i].flags = (msgs[i].flags & I2C_MSG_READ) ? I2C_M_RD : 0;
+    kmsgs[i].len = msgs[i].len;
+    kmsgs[i].buf = msgs[i].buf;
+  }
+  struct i2c_rdwr_ioctl_data rdwr;
+  rdwr.msgs = kmsgs;
+  rdwr.nmsgs = count;
+
+  if (ioctl(fd, I2C_RDWR, &rdwr) == count)
+    return I2C_REASON_OK;
+  return errnoReason();
+}
+
+/** Map the errno of a failed i2c-dev ioctl to an I2C_REASON_* code.
+ */
+uint8_t LinuxI2CTransport::errnoReason() {
+  switch (errno) {
+    case ENXIO:
+    case EREMOTEIO:
+      return I2C_REASON_ERROR_NACK;
+    case ETIMEDOUT:
+      return I2C_REASON_ERROR_CLKT;
+    case EPROTO:
+    case EBADMSG:
+      return I2C_REASON_ERROR_DATA;
+    default:
+      return I2C_REASON_ERROR_IO;
+  }
+}
+
+uint8_t LinuxI2CTransport::smbus(uint8_t addr, uint8_t readWrite, uint8_t command,
+                                 uint32_t size, union i2c_smbus_data *data) {
+  if (slaveAddr != addr) {
+    if (ioctl(fd, I2C_SLAVE, addr) < 0)
+      return errnoReason();
+    slaveAddr = addr;
+  }
+  struct i2c_smbus_ioctl_data args;
+  args.read_write = readWrite;
+  args.command = command;
+  args.size = size;
+  args.data = data;
+  return ioctl(fd, I2C_SMBUS, &args) < 0 ? errnoReason() : I2C_REASON_OK;
+}
+
+/** Emulate the message patterns used by I2Cdev with SMBus commands.
+ * Register reads and writes are split into I2C block commands of at most
+ * I2C_SMBUS_BLOCK_MAX bytes with an advancing register address, so this is
+ * only exact for devices that auto-increment (true for i2c-stub).
+ */
+uint8_t LinuxI2CTransport::smbusTransfer(I2CMessage *msgs, uint8_t count) {
+  union i2c_smbus_data data;
+  uint8_t response = I2C_REASON_OK;
+  for (uint8_t i = 0; i < count && response == I2C_REASON_OK; i++) {
+    I2CMessage *msg = &msgs[i];
+    if (!(msg->flags & I2C_MSG_READ) && msg->len == 1 && i + 1 < count &&
+        (msgs[i+1].flags & I2C_MSG_READ) && msgs[i+1].addr == msg->addr) {
+      // register address followed by a read
+      I2CMessage *rd = &msgs[++i];
+      for (uint16_t j = 0; j < rd->len && response == I2C_REASON_OK; j += I2C_SMBUS_BLOCK_MAX) {
+        uint8_t chunk = (rd->len - j > I2C_SMBUS_BLOCK_MAX) ? I2C_SMBUS_BLOCK_MAX : rd->len - j;
+        data.block[0] = chunk;
+        response = smbus(msg->addr, I2C_SMBUS_READ, msg->buf[0] + j, I2C_SMBUS_I2C_BLOCK_DATA, &data);
+        if (response == I2C_REASON_OK)
+          memcpy(rd->buf + j, &data.block[1], chunk);
+      }
+    } else if (msg->flags & I2C_MSG_READ) {
+      // bare read, only single bytes can be expressed
+      if (msg->len != 1)
+        return I2C_REASON_ERROR_IO;
+      response = smbus(msg->addr, I2C_SMBUS_READ, 0, I2C_SMBUS_BYTE, &data);
+      msg->buf[0] = data.byte;
+    } else if (msg->len == 1) {
+      // bare command byte
+      response = smbus(msg->addr, I2C_SMBUS_WRITE, msg->buf[0], I2C_SMBUS_BYTE, NULL);
+    } else {
+      // register address followed by data
+      for (uint16_t j = 1; j < msg->len && response == I2C_REASON_OK; j += I2C_SMBUS_BLOCK_MAX) {
+        uint8_t chunk = (msg->len - j > I2C_SMBUS_BLOCK_MAX) ? I2C_SMBUS_BLOCK_MAX : msg->len - j;
+        data.block[0] = chunk;
+        memcpy(&data.block[1], msg->buf + j, chunk);
+        response = smbus(msg->addr, I2C_SMBUS_WRITE, msg->buf[0] + j - 1, I2C_SMBUS_I2C_BLOCK_DATA, &data);
+      }
+    }
+  }
+  return response;
+}
@@ -0,0 +1,96 @@
+/* I2Cdev library collection - I2C transport backends
+   Moves the actual bus access out of I2Cdev so that the same device classes
+   can run on the bcm2835 peripheral or on any Linux /dev/i2c-N adapter.
+
+   A transfer is a list of messages that the backend executes as one
+   combined transaction (repeated start between messages, stop at the end).
+   The Linux backend hands the whole list to the kernel in a single I2C_RDWR
+   ioctl, so a register write followed by a burst read costs one syscall.
+   The simulated backend (I2CSimTransport.h) replaces the bus and the
+   sensors with models.
+*/
+
+#ifndef _I2CTRANSPORT_H_
+#define _I2CTRANSPORT_H_
+
+#include <stdint.h>
+
+// Message direction flags
+#define I2C_MSG_WRITE 0x00
+#define I2C_MSG_READ  0x01
+
+// Transfer status codes, numbered like bcm2835I2CReasonCodes
+#define I2C_REASON_OK          0x00
+#define I2C_REASON_ERROR_NACK  0x01
+#define I2C_REASON_ERROR_CLKT  0x02
+#define I2C_REASON_ERROR_DATA  0x04
+#define I2C_REASON_ERROR_IO    0x08
+
+// Upper bound on messages in a single transfer (I2C_RDWR_IOCTL_MAX_MSGS)
+#define I2C_TRANSFER_MAX_MSGS 42
+
+typedef struct i2c_message {
+    uint8_t addr;   // 7-bit slave address
+    uint8_t flags;  // I2C_MSG_WRITE or I2C_MSG_READ
+    uint16_t len;   // number of bytes to send or receive
+    uint8_t *buf;   // data to send, or destination for received data
+} I2CMessage;
+
+union i2c_smbus_data;
+
+class I2CTransport {
+ public:
+    virtual ~I2CTransport() { }
+
+    virtual bool begin(uint32_t baudrate) = 0;
+    virtual void end() = 0;
+    virtual uint8_t transfer(I2CMessage *msgs, uint8_t count) = 0;
+    virtual const char *name() const = 0;
+
+    static I2CTransport *create(const char *bus);
+};
+
+/** Backend for the Raspberry Pi BSC peripheral through the bcm2835 library.
+ * The slave address register is only rewritten when the target changes.
+ */
+class BCM2835Transport : public I2CTransport {
+ public:
+    BCM2835Transport();
+
+    bool begin(uint32_t baudrate);
+    void end();
+    uint8_t transfer(I2CMessage *msgs, uint8_t count);
+    const char *name() const { return "bcm2835"; }
+
+ private:
+    int16_t slaveAddr;
+    void selectSlave(uint8_t addr);
+};
+
+/** Backend for the Linux i2c-dev interface (/dev/i2c-N).
+ * Works on any adapter with a kernel driver. Adapters that only speak SMBus,
+ * such as the i2c-stub module, fall back to I2C block commands.
+ * The bus clock is fixed by the device tree, so the baud rate is ignored.
+ */
+class LinuxI2CTransport : public I2CTransport {
+ public:
+    LinuxI2CTransport(const char *device);
+    ~LinuxI2CTransport();
+
+    bool begin(uint32_t baudrate);
+    void end();
+    uint8_t transfer(I2CMessage *msgs, uint8_t count);
+    const char *name() const { return device; }
+
+ private:
+    int fd;
+    bool smbusOnly;
+    int16_t slaveAddr;
+    char device[64];
+
+    uint8_t errnoReason();
+    uint8_t smbus(uint8_t addr, uint8_t readWrite, uint8_t command, uint32_t size, union i2c_smbus_data *data);
+    uint8_t smbusTransfer(I2CMessage *msgs, uint8_t count);
+};
+
+#endif /* _I2CTRANSPORT_H_ */
@@ -36,21 +36,40 @@ THE SOFTWARE.
 #include <math.h> // required for BMP180
 #include <stdlib.h> // required for MPU6060
 #include <string.h> // required for MPU6060
+#include "I2CTransport.h"
+#include "I2CRegisterCache.h"
+#include "I2CBus.h"
+#include "I2CStats.h"
 
 
 #define set_I2C_pins  false  
 /* used to boolean for setting RPi I2C pins P1-03 (SDA) and P1-05 (SCL) to alternate function ALT0, which enables those pins for I2C interface. 
    setI2Cpin should be false, if the I2C are already configured in alt mode ... */
 
-#define i2c_baudrate 400000
-//uint32_t i2c_baudrate = 400000 ; //400 kHz, 
+// Clock of the default bus; other buses are given theirs in I2CBus::open()
+#define i2c_baudrate I2C_DEFAULT_CLOCK_HZ
 
+/* Environment variable naming the bus used by I2Cdev::initialize(), e.g. "1" or "/dev/i2c-1" for the
+   Linux i2c-dev backend. Unset (or "bcm2835") keeps the bcm2835 peripheral backend. */
+#define I2CDEV_BUS_ENV "I2CDEV_BUS"
+
+/* Static interface to the default bus (I2CBus::getDefault()). Drivers that
+   can sit on any bus take an I2CBus instead. */
 class I2Cdev {
  public:
         I2Cdev();
 
-        static void initialize();
+        static bool initialize();
+        static bool initialize(const char *bus);
         static void enable(bool isEnabled);
+        static I2CTransport *getTransport();
+        static void lockBus();
+        static void unlockBus();
+
+        static void setRegisterCache(uint8_t devAddr, I2CRegisterCache *cache);
+        static I2CRegisterCache *getRegisterCache(uint8_t devAddr);
+        static void invalidateRegisterCache(uint8_t devAddr);
+        static bool resyncRegisterCache(uint8_t devAddr);
 
         static int8_t readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data);
         //TODO static int8_t readBitW(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint16_t *data);
@@ -60,11 +79,13 @@ class I2Cdev {
         static int8_t readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data);
         static int8_t readBytes(uint8_t devAddr, uint8_t length, uint8_t *data);
         static int8_t readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
+        static int8_t readBlock(uint8_t devAddr, uint8_t regAddr, uint16_t length, uint8_t *data);
         static int8_t readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16_t *data);
 
         static bool writeBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data);
         //TODO static bool writeBitW(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint16_t data);
         static bool writeBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t data);
+        static bool writeMasked(uint8_t devAddr, uint8_t regAddr, uint8_t mask, uint8_t data);
         //TODO static bool writeBitsW(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint16_t data);
         static bool writeByte(uint8_t devAddr, uint8_t data);
         static bool writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data);
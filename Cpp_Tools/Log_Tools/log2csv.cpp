@@ -0,0 +1,178 @@
+/**
+ * Converts a binary sensor log back into the CSV layout the readers used to
+ * write directly:
+ *
+ *   MPU6050  start, end, ax, ay, az (g), gx, gy, gz (rad/s)
+ *   DMP      start, end, qw, qx, qy, qz (MPU6050 orientation quaternion)
+ *   HMC6343  start, end, yaw, pitch, roll (rad), ax, ay, az (g), temperature
+ *   SkyTraq  start, end, gps_time, fix mode, satellites, lat, long, elev,
+ *            ecef x/y/z, ecef vx/vy/vz, gdop, pdop, hdop, vdop, tdop
+ *
+ * Start and end are wall-clock times rebuilt from the monotonic record
+ * timestamps and the clock pair in the log header, updated by every time
+ * sync record that follows. Gap records become "# gap: ..." comment lines,
+ * time sync records produce no output.
+ *
+ * Usage: log2csv input.bin [output.log]
+ * Without an output name the .bin extension is replaced by .log; "-" writes to stdout.
+ */
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "BinaryLog.h"
+#include "SkyTraqMessages.h"
+
+// Wall-clock seconds and microseconds of a record timestamp, offset is realtime - record clock
+static void print_time(FILE *out, int64_t offset, uint64_t timestamp) {
+    int64_t real = (int64_t) timestamp + offset;
+    long int sec = real / 1000000000ll;
+    long int usec = real % 1000000000ll / 1000;
+    if (usec < 0) { usec += 1000000; sec--; }
+    fprintf(out, "%ld.%06ld,", sec, usec);
+}
+
+static void print_mpu6050(FILE *out, const BinaryLogHeader *header, const int16_t *v) {
+    fprintf(out,"%0.6f,%0.6f,%0.6f,", v[0]*header->scale[0], v[1]*header->scale[1], v[2]*header->scale[2]);
+    fprintf(out,"%0.6f,%0.6f,%0.6f\n", v[3]*header->scale[3], v[4]*header->scale[4], v[5]*header->scale[5]);
+}
+
+static void print_quaternion(FILE *out, const BinaryLogHeader *header, const int16_t *v) {
+    fprintf(out,"%0.6f,%0.6f,%0.6f,%0.6f\n", v[0]*header->scale[0], v[1]*header->scale[1],
+            v[2]*header->scale[2], v[3]*header->scale[3]);
+}
+
+static void print_hmc6343(FILE *out, const BinaryLogHeader *header, const int16_t *v) {
+    fprintf(out,"%0.6f,%0.6f,%0.6f,", v[0]*header->scale[0], v[1]*header->scale[1], v[2]*header->scale[2]);
+    fprintf(out,"%0.6f,%0.6f,%0.6f,", v[3]*header->scale[3], v[4]*header->scale[4], v[5]*header->scale[5]);
+    fprintf(out,"%0.4f\n", v[6]*header->scale[6]);
+}
+
+static void print_skytraq(FILE *out, const uint8_t *payload, uint16_t length) {
+    SkyTraqNavData nav;
+    if (!skytraqDecode(payload, length, &nav)) {
+        fprintf(out, "# truncated navigation message\n");
+        return;
+    }
+
+    // Generate gps-time from week and time of week
+    double tow = (double) nav.timeOfWeek / 100.0;
+    long int tow_micro = (tow - (long int)tow) * 1e6;
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year = 80;
+    tm.tm_mon = 0;
+    tm.tm_mday = 6;
+    time_t dt = mktime(&tm);
+    long int gps_sec = dt + nav.gpsWeek*7*24*60*60 + (long int)tow;
+
+    // Degrees, meters, meter/s; below sea level the altitude is two's complement
+    double lat = (double) nav.latitude / 10000000.0;
+    double lon = (double) nav.longitude / 10000000.0;
+    double elev_m = (double) (int32_t) nav.seaLevelAlt / 100.0;
+
+    fprintf(out,"%ld.%06ld,", gps_sec, tow_micro);
+    fprintf(out,"%d,%d,", nav.fixMode, nav.satellites);
+    fprintf(out,"%4.6f,%4.6f,%4.6f,", lat, lon, elev_m);
+    fprintf(out,"%4.6f,%4.6f,%4.6f,%4.6f,%4.6f,%4.6f,",
+            nav.ecefX / 100.0, nav.ecefY / 100.0, nav.ecefZ / 100.0,
+            nav.ecefVX / 100.0, nav.ecefVY / 100.0, nav.ecefVZ / 100.0);
+    fprintf(out,"%4.6f,%4.6f,%4.6f,%4.6f,%4.6f\n",
+            nav.gdop / 100.0, nav.pdop / 100.0, nav.hdop / 100.0, nav.vdop / 100.0, nav.tdop / 100.0);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s input.bin [output.log]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *in = fopen(argv[1], "rb");
+    if (in == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    BinaryLogHeader header;
+    if (!BinaryLog::readHeader(in, &header)) {
+        fprintf(stderr, "%s is not a version 1 to %d sensor log\n", argv[1], BINLOG_VERSION);
+        fclose(in);
+        return 1;
+    }
+    if ((header.device == BINLOG_DEVICE_MPU6050 && header.channels != 6) ||
+        (header.device == BINLOG_DEVICE_HMC6343 && header.channels != 7) ||
+        (header.device == BINLOG_DEVICE_MPU6050_DMP && header.channels != 4) ||
+        header.device < BINLOG_DEVICE_MPU6050 || header.device > BINLOG_DEVICE_MPU6050_DMP) {
+        fprintf(stderr, "%s: unsupported device %d with %d channels\n", argv[1], header.device, header.channels);
+        fclose(in);
+        return 1;
+    }
+
+    char out_name[1024];
+    if (argc == 3) {
+        snprintf(out_name, sizeof(out_name), "%s", argv[2]);
+    } else {
+        snprintf(out_name, sizeof(out_name), "%s", argv[1]);
+        char *ext = strrchr(out_name, '.');
+        if (ext && strcmp(ext, ".bin") == 0)
+            *ext = '\0';
+        strncat(out_name, ".log", sizeof(out_name) - strlen(out_name) - 1);
+    }
+    FILE *out = strcmp(out_name, "-") == 0 ? stdout : fopen(out_name, "w");
+    if (out == NULL) {
+        perror(out_name);
+        fclose(in);
+        return 1;
+    }
+
+    if (header.device == BINLOG_DEVICE_SKYTRAQ)
+        fprintf(out, "# start_time, end_time, gps_time, fix_mode, satellites, lat, long, elev, "
+                     "ecef_x, ecef_y, ecef_z, ecef_vx, ecef_vy, ecef_vz, "
+                     "gdop, pdop, hdop, vdop, tdop\n");
+
+    uint8_t record[BINLOG_RECORD_HEADER_SIZE + BINLOG_MAX_VALUE_SIZE];
+    const uint8_t *values = record + BINLOG_RECORD_HEADER_SIZE;
+    int16_t channels[BINLOG_MAX_CHANNELS];
+    unsigned long count = 0, gaps = 0, syncs = 0;
+    int64_t offset = header.realtimeStartNs - header.clockStartNs;
+    while (fread(record, header.recordSize, 1, in) == 1) {
+        uint64_t timestamp;
+        uint32_t latency;
+        memcpy(&timestamp, record, 8);
+        memcpy(&latency, record + 8, 4);
+        if (latency == BINLOG_GAP) {
+            uint32_t missed;
+            memcpy(&missed, values, 4);
+            if (missed)
+                fprintf(out, "# gap: %u samples missed\n", missed);
+            else
+                fprintf(out, "# gap: samples lost\n");
+            gaps++;
+            continue;
+        }
+        if (latency == BINLOG_TIMESYNC) {
+            int64_t realtime;
+            memcpy(&realtime, values, 8);
+            offset = realtime - (int64_t) timestamp;
+            syncs++;
+            continue;
+        }
+
+        print_time(out, offset, timestamp);
+        print_time(out, offset, timestamp + latency);
+        memcpy(channels, values, header.channels * sizeof(int16_t));
+        switch (header.device) {
+            case BINLOG_DEVICE_MPU6050: print_mpu6050(out, &header, channels); break;
+            case BINLOG_DEVICE_HMC6343: print_hmc6343(out, &header, channels); break;
+            case BINLOG_DEVICE_SKYTRAQ: print_skytraq(out, values, header.valueSize); break;
+            case BINLOG_DEVICE_MPU6050_DMP: print_quaternion(out, &header, channels); break;
+        }
+        count++;
+    }
+
+    fprintf(stderr, "%s: %lu records, %lu gaps, %lu time syncs\n", out_name, count, gaps, syncs);
+    fclose(in);
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
@@ -0,0 +1,271 @@
+// Binary sensor log container
+
+#include "BinaryLog.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static_assert(sizeof(BinaryLogHeader) == 224, "BinaryLogHeader layout is part of the file format");
+
+BinaryLog::BinaryLog() : fd(-1), stopping(false), block(NULL), blockUsed(0), fileOffset(0),
+                         written(0), lastTimestamp(0), droppedSeen(0), writeErrors(0), lastSync(0) {
+  memset(&header, 0, sizeof(header));
+}
+
+BinaryLog::~BinaryLog() {
+  close();
+}
+
+/** Current time on the time base of all records, see TimeBase.
+ * @return CLOCK_MONOTONIC_RAW nanoseconds
+ */
+uint64_t BinaryLog::now() {
+  return TimeBase::now();
+}
+
+/** Create a log and start its writer thread.
+ * @param path File to create
+ * @param device BINLOG_DEVICE_*
+ * @param channels Number of int16 channels per record, 0 for a raw payload
+ * @param scale Physical units per LSB for each channel, may be NULL for raw payloads
+ * @param valueSize Bytes per record for raw payloads, ignored when channels is set
+ * @param description Free text stored in the header
+ * @return True on success
+ */
+bool BinaryLog::open(const char *path, uint16_t device, uint16_t channels, const double *scale,
+                     uint16_t valueSize, const char *description) {
+  close();
+  if (channels > BINLOG_MAX_CHANNELS || (channels && !scale))
+    return false;
+  if (channels)
+    valueSize = channels * sizeof(int16_t);
+  if (valueSize == 0 || valueSize > BINLOG_MAX_VALUE_SIZE)
+    return false;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, BINLOG_MAGIC, sizeof(BINLOG_MAGIC));
+  header.version = BINLOG_VERSION;
+  header.headerSize = sizeof(BinaryLogHeader);
+  header.device = device;
+  header.channels = channels;
+  header.valueSize = valueSize;
+  header.recordSize = BINLOG_RECORD_HEADER_SIZE + valueSize;
+  for (uint16_t i = 0; i < channels; i++)
+    header.scale[i] = scale[i];
+  if (description)
+    strncpy(header.description, description, sizeof(header.description) - 1);
+
+  // Sample both clocks together so wall time can be recovered later
+  header.clockId = TIMEBASE_CLOCK;
+  TimeBase::samplePair(&header.clockStartNs, &header.realtimeStartNs);
+
+  if (!ring.begin(header.recordSize, BINLOG_RING_RECORDS) ||
+      posix_memalign((void **) &block, BINLOG_BLOCK_SIZE, BINLOG_BLOCK_SIZE) != 0) {
+    fprintf(stderr, "BinaryLog: out of memory\n");
+    block = NULL;
+    ring.end();
+    return false;
+  }
+  fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    perror(path);
+    free(block);
+    block = NULL;
+    ring.end();
+    return false;
+  }
+
+  // The header opens the first block and is rewritten in place at close
+  memcpy(block, &header, sizeof(header));
+  blockUsed = sizeof(header);
+  fileOffset = 0;
+  written = 0;
+  lastTimestamp = header.clockStartNs;
+  droppedSeen = 0;
+  writeErrors = 0;
+  lastSync = header.clockStartNs;
+  stopping.store(false);
+  writer = std::thread(&BinaryLog::writerLoop, this);
+  return true;
+}
+
+/** Stop the writer thread, write out everything still queued, rewrite the
+ * header with any late settings and close the file.
+ */
+void BinaryLog::close() {
+  if (fd < 0)
+    return;
+  stopping.store(true, std::memory_order_release);
+  writer.join();
+  if (pwrite(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header))
+    writeErrors++;
+  if (writeErrors)
+    fprintf(stderr, "BinaryLog: %u failed writes\n", writeErrors);
+  ::close(fd);
+  fd = -1;
+  free(block);
+  block = NULL;
+  ring.end();
+}
+
+/** Replace the clock pair sampled at open() with one shared by a set of logs.
+ * @param clockStartNs Record clock time of the reference point, see TimeBase::samplePair()
+ * @param realtimeStartNs CLOCK_REALTIME at the same moment
+ */
+void BinaryLog::setTimeReference(int64_t clockStartNs, int64_t realtimeStartNs) {
+  header.clockStartNs = clockStartNs;
+  header.realtimeStartNs = realtimeStartNs;
+}
+
+/** Report ring usage, e.g. at shutdown after close().
+ */
+void BinaryLog::printStats(FILE *out) const {
+  fprintf(out, "Log buffer: %llu records written, high-water %u of %u records, %u dropped\n",
+          (unsigned long long) written, getHighWater(), getCapacity(), getDropped());
+}
+
+/** Queue one sample for the writer thread. Never blocks; if the ring is full
+ * the sample is dropped and counted.
+ * @param timestamp Sample time from now()
+ * @param latency Nanoseconds from the sample time until the read completed
+ * @param values header.valueSize bytes of sample data
+ */
+void BinaryLog::write(uint64_t timestamp, uint32_t latency, const void *values) {
+  uint8_t *record = ring.reserve();
+  if (record == NULL)
+    return;
+  memcpy(record, &timestamp, 8);
+  memcpy(record + 8, &latency, 4);
+  memcpy(record + BINLOG_RECORD_HEADER_SIZE, values, header.valueSize);
+  ring.publish();
+}
+
+/** Mark lost samples.
+ * @param timestamp When the loss was detected
+ * @param missed Number of samples lost, 0 if unknown
+ */
+void BinaryLog::writeGap(uint64_t timestamp, uint32_t missed) {
+  uint8_t values[BINLOG_MAX_VALUE_SIZE];
+  memset(values, 0, sizeof(values));
+  memcpy(values, &missed, 4);
+  write(timestamp, BINLOG_GAP, values);
+}
+
+void BinaryLog::writerLoop() {
+  struct timespec period = { 0, BINLOG_WRITER_PERIOD_MS * 1000000L };
+  for (;;) {
+    bool stop = stopping.load(std::memory_order_acquire);
+    drain();
+    if (stop || now() - lastSync >= BINLOG_TIMESYNC_PERIOD_S * 1000000000ull)
+      markTimeSync();
+    if (stop)
+      break;
+    nanosleep(&period, NULL);
+  }
+  // Whatever is left makes up the only partial block of the file
+  flushBlock();
+}
+
+/** Move everything queued in the ring into output blocks.
+ */
+void BinaryLog::drain() {
+  const uint8_t *records;
+  uint32_t count;
+  while ((count = ring.peek(&records)) > 0) {
+    markDropped();
+    append(records, count * header.recordSize);
+    memcpy(&lastTimestamp, records + (count - 1) * header.recordSize, 8);
+    written += count;
+    ring.release(count);
+  }
+  markDropped();
+}
+
+/** Insert a gap record for samples the producer dropped since the last check,
+ * at the time of the last record that made it.
+ */
+void BinaryLog::markDropped() {
+  uint32_t dropped = ring.getDropped();
+  if (dropped == droppedSeen)
+    return;
+  uint8_t gap[BINLOG_RECORD_HEADER_SIZE + BINLOG_MAX_VALUE_SIZE];
+  uint32_t latency = BINLOG_GAP, missed = dropped - droppedSeen;
+  memset(gap, 0, sizeof(gap));
+  memcpy(gap, &lastTimestamp, 8);
+  memcpy(gap + 8, &latency, 4);
+  memcpy(gap + BINLOG_RECORD_HEADER_SIZE, &missed, 4);
+  append(gap, header.recordSize);
+  droppedSeen = dropped;
+}
+
+/** Append a time sync marker with a fresh clock pair. It follows every
+ * record drained so far, so readers apply it from here on. Needs eight value
+ * bytes, which every log format has.
+ */
+void BinaryLog::markTimeSync() {
+  int64_t clockNs, realtimeNs;
+  TimeBase::samplePair(&clockNs, &realtimeNs);
+  lastSync = clockNs;
+  if (header.valueSize < 8)
+    return;
+  uint8_t sync[BINLOG_RECORD_HEADER_SIZE + BINLOG_MAX_VALUE_SIZE];
+  uint32_t latency = BINLOG_TIMESYNC;
+  memset(sync, 0, sizeof(sync));
+  memcpy(sync, &clockNs, 8);
+  memcpy(sync + 8, &latency, 4);
+  memcpy(sync + BINLOG_RECORD_HEADER_SIZE, &realtimeNs, 8);
+  append(sync, header.recordSize);
+}
+
+void BinaryLog::append(const uint8_t *data, uint32_t length) {
+  while (length > 0) {
+    uint32_t n = BINLOG_BLOCK_SIZE - blockUsed;
+    if (n > length)
+      n = length;
+    memcpy(block + blockUsed, data, n);
+    blockUsed += n;
+    data += n;
+    length -= n;
+    if (blockUsed == BINLOG_BLOCK_SIZE)
+      flushBlock();
+  }
+}
+
+/** Write the current block at its aligned file offset.
+ */
+void BinaryLog::flushBlock() {
+  uint32_t done = 0;
+  while (done < blockUsed) {
+    ssize_t n = pwrite(fd, block + done, blockUsed - done, fileOffset + done);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0) {
+      writeErrors++;
+      break;
+    }
+    done += n;
+  }
+  fileOffset += blockUsed;
+  blockUsed = 0;
+}
+
+/** Read and check the header of an existing log.
+ * Leaves the file positioned at the first record.
+ * @return False if the file is not a log this version understands
+ */
+bool BinaryLog::readHeader(FILE *file, BinaryLogHeader *header) {
+  memset(header, 0, sizeof(*header));
+  if (fread(header, 1, 16, file) != 16 || memcmp(header->magic, BINLOG_MAGIC, sizeof(BINLOG_MAGIC)) != 0)
+    return false;
+  if (header->version < 1 || header->version > BINLOG_VERSION || header->headerSize < sizeof(BinaryLogHeader))
+    return false;
+  if (fread((char *) header + 16, 1, sizeof(BinaryLogHeader) - 16, file) != sizeof(BinaryLogHeader) - 16)
+    return false;
+  if (header->recordSize != BINLOG_RECORD_HEADER_SIZE + header->valueSize ||
+      header->valueSize > BINLOG_MAX_VALUE_SIZE || header->channels > BINLOG_MAX_CHANNELS)
+    return false;
+  return fseek(file, header->headerSize, SEEK_SET) == 0;
+}
@@ -0,0 +1,136 @@
+/* Binary sensor log container
+   A log is one BinaryLogHeader followed by fixed-size records:
+
+       uint64_t timestamp   sample time, ns on the header's clock (CLOCK_MONOTONIC_RAW,
+                            CLOCK_MONOTONIC in version 1 logs)
+       uint32_t latency     ns from the sample time to the end of the read,
+                            or BINLOG_GAP / BINLOG_TIMESYNC for a marker
+       uint8_t  values[valueSize]
+
+   For the I2C sensors the values are the raw int16 channels exactly as the
+   driver returned them; header.scale[] turns them into physical units. For
+   the GPS they are the raw navigation data payload as received. Gap markers
+   carry the number of lost samples (0 if unknown) in the first four value
+   bytes. Time sync markers carry the CLOCK_REALTIME nanoseconds (int64) at
+   their timestamp in the first eight value bytes. Everything is stored in
+   host byte order (little endian on the Pi).
+
+   Records are not written by the caller. write() only copies the record
+   into a lock-free SPSC ring and returns; a writer thread drains the ring
+   every BINLOG_WRITER_PERIOD_MS into a 64 KiB block and writes whole blocks
+   at block-aligned file offsets. A storage stall therefore never delays the
+   sampling loop. If the ring fills up the record is dropped and counted,
+   and the writer inserts a gap record for it.
+
+   Wall-clock time is recovered from the clock pair sampled when the log was
+   opened: realtime = realtimeStartNs + (timestamp - clockStartNs). Logs
+   recorded together can share one pair through setTimeReference(), so that
+   they convert to exactly the same wall clock. The writer thread adds a
+   fresh pair as a time sync marker every BINLOG_TIMESYNC_PERIOD_S and at
+   close, which a reader applies to the records that follow it. A wall
+   clock stepped or slewed during the run therefore shows up in the wall
+   times but never in the record order or the intervals (see TimeBase.h).
+   Log_Tools/log2csv turns a log back into the CSV the readers used to write.
+*/
+
+#ifndef _BINARYLOG_H_
+#define _BINARYLOG_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include "SPSCRing.h"
+#include "TimeBase.h"
+
+#define BINLOG_MAGIC "RPISLOG"
+#define BINLOG_VERSION 2
+
+// Devices
+#define BINLOG_DEVICE_MPU6050 1
+#define BINLOG_DEVICE_HMC6343 2
+#define BINLOG_DEVICE_SKYTRAQ 3
+#define BINLOG_DEVICE_MPU6050_DMP 4
+
+#define BINLOG_MAX_CHANNELS      16
+#define BINLOG_MAX_VALUE_SIZE    64
+#define BINLOG_RECORD_HEADER_SIZE 12
+#define BINLOG_GAP               0xFFFFFFFF
+#define BINLOG_TIMESYNC          0xFFFFFFFE
+
+// Ring capacity, about 16 s of IMU records at 1 kHz
+#define BINLOG_RING_RECORDS      16384
+// Output block size, every write() but the last covers one whole aligned block
+#define BINLOG_BLOCK_SIZE        (64 * 1024)
+#define BINLOG_WRITER_PERIOD_MS  50
+// Interval between time sync markers
+#define BINLOG_TIMESYNC_PERIOD_S 10
+
+typedef struct binary_log_header {
+    char magic[8];              // BINLOG_MAGIC
+    uint16_t version;           // BINLOG_VERSION
+    uint16_t headerSize;        // sizeof(BinaryLogHeader), records start here
+    uint16_t device;            // BINLOG_DEVICE_*
+    uint16_t channels;          // int16 channels per record, 0 for raw payloads
+    uint16_t valueSize;         // bytes of sample data per record
+    uint16_t recordSize;        // BINLOG_RECORD_HEADER_SIZE + valueSize
+    uint32_t flags;             // reserved, 0
+    uint32_t samplePeriodNs;    // nominal sample period, 0 if irregular
+    int32_t clockId;            // clock of the record timestamps
+    int64_t clockStartNs;       // that clock when the log was opened
+    int64_t realtimeStartNs;    // CLOCK_REALTIME at the same moment
+    double scale[BINLOG_MAX_CHANNELS]; // physical units per LSB of each channel
+    char description[48];       // free text, e.g. the configured ranges
+} BinaryLogHeader;
+
+class BinaryLog {
+ public:
+    BinaryLog();
+    ~BinaryLog();
+
+    bool open(const char *path, uint16_t device, uint16_t channels, const double *scale,
+              uint16_t valueSize=0, const char *description=0);
+    void close();
+    bool isOpen() const { return fd >= 0; }
+
+    void setSamplePeriod(uint32_t ns) { header.samplePeriodNs = ns; }
+    void setTimeReference(int64_t clockStartNs, int64_t realtimeStartNs);
+
+    void write(uint64_t timestamp, uint32_t latency, const void *values);
+    void writeGap(uint64_t timestamp, uint32_t missed);
+
+    const BinaryLogHeader *getHeader() const { return &header; }
+    uint32_t getHighWater() const { return ring.getHighWater(); }
+    uint32_t getDropped() const { return ring.getDropped(); }
+    uint32_t getCapacity() const { return ring.getCapacity(); }
+    void printStats(FILE *out) const;
+
+    static uint64_t now();
+    static bool readHeader(FILE *file, BinaryLogHeader *header);
+
+ private:
+    int fd;
+    BinaryLogHeader header;
+    SPSCRing ring;
+    std::thread writer;
+    std::atomic<bool> stopping;
+
+    // Writer thread state
+    uint8_t *block;
+    uint32_t blockUsed;
+    uint64_t fileOffset;
+    uint64_t written;
+    uint64_t lastTimestamp;
+    uint32_t droppedSeen;
+    uint32_t writeErrors;
+    uint64_t lastSync;
+
+    void writerLoop();
+    void drain();
+    void markDropped();
+    void markTimeSync();
+    void append(const uint8_t *data, uint32_t length);
+    void flushBlock();
+};
+
+#endif /* _BINARYLOG_H_ */
@@ -0,0 +1,60 @@
+// Latency histogram
+
+#include "LatencyHistogram.h"
+#include <string.h>
+
+void LatencyHistogram::reset() {
+  memset(buckets, 0, sizeof(buckets));
+  count = sum = max = 0;
+  min = UINT64_MAX;
+}
+
+/** Count one duration.
+ * @param ns Nanoseconds
+ */
+void LatencyHistogram::add(uint64_t ns) {
+  int bucket = ns ? 64 - __builtin_clzll(ns) : 0;
+  if (bucket >= LATENCY_HISTOGRAM_BUCKETS)
+    bucket = LATENCY_HISTOGRAM_BUCKETS - 1;
+  buckets[bucket]++;
+  count++;
+  sum += ns;
+  if (ns < min)
+    min = ns;
+  if (ns > max)
+    max = ns;
+}
+
+/** Upper bound of the given percentile, resolved to a bucket edge.
+ * @param percent 0 to 100
+ * @return Nanoseconds, at most the maximum seen
+ */
+uint64_t LatencyHistogram::getPercentile(double percent) const {
+  uint64_t rank = (uint64_t) (count * percent / 100.0), seen = 0;
+  for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+    seen += buckets[i];
+    if (seen > rank || seen == count) {
+      uint64_t bound = 1ull << i;
+      return bound < max ? bound : max;
+    }
+  }
+  return max;
+}
+
+/** Summary line followed by the occupied buckets, e.g.
+ *  "lateness: 1000 samples, min 12.1 us, mean 40.2 us, 99% < 65.5 us, max 130.0 us"
+ */
+void LatencyHistogram::print(FILE *out, const char *name) const {
+  fprintf(out, "%s: %llu samples", name, (unsigned long long) count);
+  if (count == 0) {
+    fprintf(out, "\n");
+    return;
+  }
+  fprintf(out, ", min %0.1f us, mean %0.1f us, 99%% < %0.1f us, max %0.1f us\n ",
+          getMin() / 1e3, getMean() / 1e3, getPercentile(99) / 1e3, max / 1e3);
+  for (int i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+    if (buckets[i])
+      fprintf(out, " <%0.1fus:%llu", (1ull << i) / 1e3, (unsigned long long) buckets[i]);
+  }
+  fprintf(out, "\n");
+}
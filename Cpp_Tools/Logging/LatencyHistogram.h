@@ -0,0 +1,40 @@
+/* Latency histogram
+   Counts durations in power-of-two nanosecond buckets: bucket i holds
+   values below 2^i ns and at least half that, so 32 buckets cover 1 ns to
+   about 2 s at a constant relative resolution. Exact count, minimum, mean
+   and maximum are kept alongside. Adding a value is a few instructions and
+   never allocates, so it can sit in a sampling loop. Not thread safe, each
+   histogram belongs to the thread that fills it.
+*/
+
+#ifndef _LATENCYHISTOGRAM_H_
+#define _LATENCYHISTOGRAM_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define LATENCY_HISTOGRAM_BUCKETS 32
+
+class LatencyHistogram {
+ public:
+    LatencyHistogram() { reset(); }
+
+    void reset();
+    void add(uint64_t ns);
+
+    uint64_t getCount() const { return count; }
+    uint64_t getMin() const { return count ? min : 0; }
+    uint64_t getMax() const { return max; }
+    double getMean() const { return count ? (double) sum / count : 0; }
+    uint64_t getPercentile(double percent) const;
+    void print(FILE *out, const char *name) const;
+
+ private:
+    uint64_t buckets[LATENCY_HISTOGRAM_BUCKETS];
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+};
+
+#endif /* _LATENCYHISTOGRAM_H_ */
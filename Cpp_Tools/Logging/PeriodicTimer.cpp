@@ -0,0 +1,67 @@
+// Absolute-deadline periodic loop
+
+#include "PeriodicTimer.h"
+#include <errno.h>
+#include <time.h>
+
+PeriodicTimer::PeriodicTimer(uint64_t periodNs) : period(periodNs) {
+  start();
+}
+
+/** Current CLOCK_MONOTONIC time, the clock of the release grid.
+ * @return Nanoseconds
+ */
+uint64_t PeriodicTimer::now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/** Start the grid and clear the statistics.
+ * @param epochNs First release (CLOCK_MONOTONIC), 0 for now
+ */
+void PeriodicTimer::start(uint64_t epochNs) {
+  release = epochNs ? epochNs : now();
+  releases = overruns = skipped = 0;
+  lateness.reset();
+  slack.reset();
+}
+
+/** Sleep until the next release.
+ * @return Releases skipped because the work overran them, 0 normally
+ */
+uint32_t PeriodicTimer::wait() {
+  uint64_t next = release + period;
+  uint64_t current = now();
+  uint32_t missed = 0;
+  if (current >= next) {
+    // Overrun, continue with the latest release that has passed
+    missed = (current - next) / period;
+    next += missed * period;
+    overruns++;
+    skipped += missed;
+  } else {
+    slack.add(next - current);
+    struct timespec ts;
+    ts.tv_sec = next / 1000000000ull;
+    ts.tv_nsec = next % 1000000000ull;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+      ;
+    current = now();
+  }
+  lateness.add(current - next);
+  release = next;
+  releases++;
+  return missed;
+}
+
+/** Loop summary with the lateness and slack histograms, e.g. at shutdown or
+ * on request while running.
+ */
+void PeriodicTimer::printStats(FILE *out, const char *name) const {
+  fprintf(out, "%s loop: %0.3f ms period, %llu releases, %llu overruns (%llu releases skipped)\n",
+          name, period / 1e6, (unsigned long long) releases,
+          (unsigned long long) overruns, (unsigned long long) skipped);
+  lateness.print(out, "  lateness");
+  slack.print(out, "  slack");
+}
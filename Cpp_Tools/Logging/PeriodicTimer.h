@@ -0,0 +1,59 @@
+/* Absolute-deadline periodic loop
+   Releases a loop on a fixed grid, epoch + k * period, by sleeping with
+   clock_nanosleep(TIMER_ABSTIME) until the next release instead of for a
+   fixed delay after the work. The loop's own run time and the wakeup
+   latency therefore never accumulate, and the loop runs at exactly its
+   nominal rate (on CLOCK_MONOTONIC, as clock_nanosleep() cannot sleep on
+   the raw clock of the logs).
+
+   If the work overruns past the next release, wait() returns at once for
+   the latest release that has passed and reports the releases it skipped,
+   so the loop stays on the grid rather than running late from then on.
+
+       PeriodicTimer timer(1000000);
+       timer.start();
+       while (!done) {
+           work();
+           uint32_t skipped = timer.wait();
+       }
+
+   Every wait() records the slack left before the next release (the work
+   finished that much early) and the lateness of the wakeup after it.
+*/
+
+#ifndef _PERIODICTIMER_H_
+#define _PERIODICTIMER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include "LatencyHistogram.h"
+
+class PeriodicTimer {
+ public:
+    PeriodicTimer(uint64_t periodNs);
+
+    void start(uint64_t epochNs=0);
+    uint32_t wait();
+
+    uint64_t getPeriod() const { return period; }
+    uint64_t getRelease() const { return release; }
+    uint64_t getReleases() const { return releases; }
+    uint64_t getOverruns() const { return overruns; }
+    uint64_t getSkipped() const { return skipped; }
+    const LatencyHistogram &getLateness() const { return lateness; }
+    const LatencyHistogram &getSlack() const { return slack; }
+    void printStats(FILE *out, const char *name) const;
+
+    static uint64_t now();
+
+ private:
+    uint64_t period;
+    uint64_t release;       // current release, CLOCK_MONOTONIC
+    uint64_t releases;
+    uint64_t overruns;      // waits that found the next release already passed
+    uint64_t skipped;       // releases dropped by those overruns
+    LatencyHistogram lateness;  // wakeup time after the release
+    LatencyHistogram slack;     // time left before the next release, overruns excluded
+};
+
+#endif /* _PERIODICTIMER_H_ */
@@ -0,0 +1,86 @@
+// Opt-in real-time execution
+
+#include "RealTime.h"
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// Touch every page of a stack frame this size, so the stack is mapped and locked down to there
+static void __attribute__((noinline)) prefaultStack() {
+  volatile unsigned char stack[REALTIME_STACK_PREFAULT];
+  long page = sysconf(_SC_PAGESIZE);
+  for (size_t i = 0; i < sizeof(stack); i += page)
+    stack[i] = 0;
+}
+
+/** Lock the process into RAM, including everything mapped later, and
+ * prefault the calling thread's stack. Call it before the buffers are
+ * allocated and the threads are started.
+ * @return False if the memory could not be locked
+ */
+bool RealTime::lockMemory() {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    perror("mlockall");
+    return false;
+  }
+  // Freed memory stays in the heap instead of being unmapped and faulted in again
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+  prefaultStack();
+  return true;
+}
+
+/** Run a thread under SCHED_FIFO, optionally on a core of its own.
+ * @param thread Thread to configure, pthread_self() or a std::thread's native_handle()
+ * @param name Thread name for ps and top, at most 15 characters
+ * @param priority SCHED_FIFO priority, 1 to 99
+ * @param cpu Core to pin the thread to, -1 to leave the affinity alone
+ * @return True if every step succeeded
+ */
+bool RealTime::configureThread(pthread_t thread, const char *name, int priority, int cpu) {
+  pthread_setname_np(thread, name);
+  bool ok = pinThread(thread, cpu);
+  struct sched_param param;
+  memset(&param, 0, sizeof(param));
+  param.sched_priority = priority;
+  int err = pthread_setschedparam(thread, SCHED_FIFO, &param);
+  if (err != 0) {
+    fprintf(stderr, "%s: SCHED_FIFO priority %d: %s\n", name, priority, strerror(err));
+    return false;
+  }
+  if (cpu >= 0)
+    printf("%s thread: SCHED_FIFO priority %d on CPU %d\n", name, priority, cpu);
+  else
+    printf("%s thread: SCHED_FIFO priority %d\n", name, priority);
+  return ok;
+}
+
+/** Restrict a thread to one core.
+ * @param cpu Core number, -1 does nothing
+ * @return False if the affinity could not be set
+ */
+bool RealTime::pinThread(pthread_t thread, int cpu) {
+  if (cpu < 0)
+    return true;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  int err = pthread_setaffinity_np(thread, sizeof(set), &set);
+  if (err != 0) {
+    fprintf(stderr, "CPU %d affinity: %s\n", cpu, strerror(err));
+    return false;
+  }
+  return true;
+}
+
+/** Core for the index'th sampling thread. Cores are handed out from the last
+ * one down, core 0 is left for the writers and the rest of the system.
+ * @return Core number, -1 if there are not enough cores to isolate it
+ */
+int RealTime::cpuForThread(int index) {
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  return cpus - 1 - index >= 1 ? cpus - 1 - index : -1;
+}
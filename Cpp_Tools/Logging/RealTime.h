@@ -0,0 +1,47 @@
+/* Opt-in real-time execution
+   On a loaded Pi an ordinary SCHED_OTHER process can be preempted or hit a
+   page fault for milliseconds at a time, which shows up as gaps in a 1 kHz
+   log. In real-time mode (-r in the readers and the daemon)
+
+   - lockMemory() locks every current and future mapping into RAM and keeps
+     malloc from returning memory to the kernel. Buffers allocated after it,
+     such as the BinaryLog ring and blocks and the stacks of threads created
+     later, are populated as they are mapped, so the sampling loops never
+     fault. The growing main thread stack is prefaulted explicitly.
+   - configureThread() gives each sampling thread its own SCHED_FIFO
+     priority and pins it to a core of its own, counted down from the last
+     one. Boot with isolcpus= on those cores to keep everything else off
+     them. The log writer threads stay SCHED_OTHER on the remaining cores.
+
+   Sampling threads hand data to everything else through lock-free queues
+   only (BinaryLog's SPSC ring, the daemon's eventfd), so they never block on
+   a thread of lower priority. The I2C bus lock inherits priority for the
+   same reason.
+   Worst-case wakeup latency is reported by the loops themselves
+   (PeriodicTimer, I2CScheduler). Needs CAP_SYS_NICE and CAP_IPC_LOCK, or
+   root; without them each step fails with a message and the program runs
+   on without it.
+*/
+
+#ifndef _REALTIME_H_
+#define _REALTIME_H_
+
+#include <stddef.h>
+#include <pthread.h>
+
+// SCHED_FIFO priorities of the sampling threads
+#define REALTIME_PRIORITY_IMU 80
+#define REALTIME_PRIORITY_MAG 70
+#define REALTIME_PRIORITY_GPS 60
+// Main thread stack prefaulted by lockMemory()
+#define REALTIME_STACK_PREFAULT (256 * 1024)
+
+class RealTime {
+ public:
+    static bool lockMemory();
+    static bool configureThread(pthread_t thread, const char *name, int priority, int cpu);
+    static bool pinThread(pthread_t thread, int cpu);
+    static int cpuForThread(int index);
+};
+
+#endif /* _REALTIME_H_ */
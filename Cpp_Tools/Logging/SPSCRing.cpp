@@ -0,0 +1,95 @@
+// Lock-free single-producer/single-consumer ring of fixed-size records
+
+#include "SPSCRing.h"
+#include <stdlib.h>
+#include <string.h>
+
+SPSCRing::SPSCRing() : storage(NULL), recordSize(0), capacity(0), mask(0),
+                       head(0), tail(0), highWater(0), dropped(0) {
+}
+
+SPSCRing::~SPSCRing() {
+  end();
+}
+
+/** Allocate the ring.
+ * @param recordSize Bytes per record
+ * @param capacity Number of records, rounded up to a power of two
+ * @return True on success
+ */
+bool SPSCRing::begin(uint32_t recordSize, uint32_t capacity) {
+  end();
+  uint32_t size = 1;
+  while (size < capacity)
+    size <<= 1;
+  if (posix_memalign((void **) &storage, 64, (size_t) size * recordSize) != 0) {
+    storage = NULL;
+    return false;
+  }
+  // Touch every page now so the producer never takes a page fault later
+  memset(storage, 0, (size_t) size * recordSize);
+  this->recordSize = recordSize;
+  this->capacity = size;
+  mask = size - 1;
+  head.store(0);
+  tail.store(0);
+  highWater.store(0);
+  dropped.store(0);
+  return true;
+}
+
+void SPSCRing::end() {
+  free(storage);
+  storage = NULL;
+}
+
+/** Get the slot for the next record without publishing it.
+ * @return Slot to fill, or NULL if the ring is full (counted as dropped)
+ */
+uint8_t *SPSCRing::reserve() {
+  uint32_t h = head.load(std::memory_order_relaxed);
+  uint32_t used = h - tail.load(std::memory_order_acquire);
+  if (used >= capacity) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return NULL;
+  }
+  if (used + 1 > highWater.load(std::memory_order_relaxed))
+    highWater.store(used + 1, std::memory_order_relaxed);
+  return storage + (size_t) (h & mask) * recordSize;
+}
+
+/** Make the record filled in through reserve() visible to the consumer.
+ */
+void SPSCRing::publish() {
+  head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+/** Copy a record into the ring. Never blocks.
+ * @return False if the ring was full and the record was dropped
+ */
+bool SPSCRing::push(const void *record) {
+  uint8_t *slot = reserve();
+  if (slot == NULL)
+    return false;
+  memcpy(slot, record, recordSize);
+  publish();
+  return true;
+}
+
+/** Get the oldest unread records that are contiguous in memory.
+ * @param records Set to the first record
+ * @return Number of records available at *records
+ */
+uint32_t SPSCRing::peek(const uint8_t **records) {
+  uint32_t t = tail.load(std::memory_order_relaxed);
+  uint32_t available = head.load(std::memory_order_acquire) - t;
+  uint32_t contiguous = capacity - (t & mask);
+  *records = storage + (size_t) (t & mask) * recordSize;
+  return available < contiguous ? available : contiguous;
+}
+
+/** Hand records obtained from peek() back to the producer.
+ */
+void SPSCRing::release(uint32_t count) {
+  tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
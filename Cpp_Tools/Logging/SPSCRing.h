@@ -0,0 +1,49 @@
+/* Lock-free single-producer/single-consumer ring of fixed-size records
+   The producer (an acquisition loop) and the consumer (a writer thread) each
+   own one index, so neither side ever waits for the other. A push into a
+   full ring fails immediately instead of blocking; the caller counts it as
+   dropped. The consumer reads records in place, in contiguous batches, and
+   releases them afterwards.
+*/
+
+#ifndef _SPSCRING_H_
+#define _SPSCRING_H_
+
+#include <stdint.h>
+#include <atomic>
+
+class SPSCRing {
+ public:
+    SPSCRing();
+    ~SPSCRing();
+
+    bool begin(uint32_t recordSize, uint32_t capacity);
+    void end();
+
+    // Producer side
+    bool push(const void *record);
+    uint8_t *reserve();
+    void publish();
+
+    // Consumer side
+    uint32_t peek(const uint8_t **records);
+    void release(uint32_t count);
+
+    uint32_t getCapacity() const { return capacity; }
+    uint32_t getHighWater() const { return highWater.load(std::memory_order_relaxed); }
+    uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+ private:
+    uint8_t *storage;
+    uint32_t recordSize;
+    uint32_t capacity;
+    uint32_t mask;
+
+    // Indices are free running and live on their own cache lines
+    alignas(64) std::atomic<uint32_t> head;     // written by the producer
+    alignas(64) std::atomic<uint32_t> tail;     // written by the consumer
+    alignas(64) std::atomic<uint32_t> highWater;
+    std::atomic<uint32_t> dropped;
+};
+
+#endif /* _SPSCRING_H_ */
@@ -0,0 +1,134 @@
+// Sensor sample clock reconstruction
+
+#include "SampleClock.h"
+#include <math.h>
+
+SampleClock::SampleClock(double nominalPeriodNs, uint32_t window) {
+  lambda = window > 1 ? 1.0 - 1.0 / window : 0.0;
+  reset(nominalPeriodNs);
+}
+
+/** Forget everything and start numbering samples from 0.
+ * @param nominalPeriodNs Configured sample period, used until the fit takes over
+ */
+void SampleClock::reset(double nominalPeriodNs) {
+  nominalPeriod = nominalPeriodNs;
+  priorPeriod = nominalPeriodNs;
+  next = 0;
+  drains = totalDrains = gaps = 0;
+  origin = 0;
+  lastStamp = 0;
+  weight = meanX = meanY = covXX = covXY = 0;
+  envelope = 0;
+  residualVar = 0;
+}
+
+// Fitted drain time (relative to origin) of sample index x
+double SampleClock::fit(double x) const {
+  return meanY + getPeriod() * (x - meanX);
+}
+
+/** Account for one drain of the sensor buffer.
+ * @param drainNs Host time the drain completed
+ * @param count Samples delivered by the drain
+ * @return Index of the first of them, pass index + i to timestamp()
+ */
+uint64_t SampleClock::update(uint64_t drainNs, uint32_t count) {
+  uint64_t first = next;
+  if (count == 0)
+    return first;
+  if (totalDrains == 0)
+    origin = drainNs;
+  next += count;
+
+  double x = (double) (next - 1);
+  double y = (double) (int64_t) (drainNs - origin);
+  if (drains > 0) {
+    // Residual against the fit so far, before this drain moves it
+    double r = y - fit(x);
+    envelope = r < envelope * lambda ? r : envelope * lambda;
+    residualVar = lambda * residualVar + (1 - lambda) * r * r;
+  }
+
+  // Exponentially weighted Welford update of the means and (co)variances
+  weight = lambda * weight + 1;
+  double dx = x - meanX;
+  meanX += dx / weight;
+  meanY += (y - meanY) / weight;
+  covXX = lambda * covXX + dx * (x - meanX);
+  covXY = lambda * covXY + dx * (y - meanY);
+  drains++;
+  totalDrains++;
+  return first;
+}
+
+/** Samples were lost, e.g. the FIFO overflowed and was reset.
+ * Sample numbering continues from the time elapsed since the last drain,
+ * the period estimate and the delay envelope are kept and the offset fit
+ * starts over.
+ * @param drainNs Host time the loss was noticed
+ */
+void SampleClock::gap(uint64_t drainNs) {
+  gaps++;
+  if (totalDrains == 0)
+    return;
+  double period = getPeriod();
+  double behind = ((double) (int64_t) (drainNs - origin) - fit(next - 1)) / period;
+  if (behind > 0)
+    next += (uint64_t) behind;
+  priorPeriod = period;
+  drains = 0;
+  weight = meanX = meanY = covXX = covXY = 0;
+}
+
+/** Reconstructed sample time.
+ * Stamps never run backwards and are never later than the drain that
+ * delivered the sample.
+ * @param index Sample index from update()
+ * @param drainNs Host time of the drain that delivered it
+ * @return Host time in the drain time's clock
+ */
+uint64_t SampleClock::timestamp(uint64_t index, uint64_t drainNs) {
+  uint64_t stamp = drainNs;
+  if (drains > 0) {
+    double t = (double) origin + fit((double) index) + envelope;
+    if (t < (double) drainNs)
+      stamp = (uint64_t) t;
+  }
+  if (stamp <= lastStamp && lastStamp < drainNs)
+    stamp = lastStamp + 1;
+  lastStamp = stamp;
+  return stamp;
+}
+
+/** Sensor sample period in host nanoseconds, fitted once enough drains were seen.
+ */
+double SampleClock::getPeriod() const {
+  if (drains >= SAMPLECLOCK_MIN_DRAINS && covXX > 0)
+    return covXY / covXX;
+  return priorPeriod;
+}
+
+/** How far the sensor clock runs from its nominal rate.
+ * @return Parts per million, positive when samples come slower than nominal
+ */
+double SampleClock::getDriftPPM() const {
+  return nominalPeriod > 0 ? (getPeriod() / nominalPeriod - 1) * 1e6 : 0;
+}
+
+/** RMS scatter of the drain times around the fit, which is the jitter that
+ * back-dating from the drain time would have put into every timestamp.
+ * @return Nanoseconds
+ */
+double SampleClock::getJitterNs() const {
+  return sqrt(residualVar);
+}
+
+/** One line summary, e.g. at shutdown.
+ */
+void SampleClock::printStats(FILE *out, const char *name) const {
+  fprintf(out, "%s clock: period %0.3f us (nominal %0.3f us, %+0.1f ppm), drain jitter %0.1f us rms, "
+          "%llu samples in %llu drains, %llu gaps\n",
+          name, getPeriod() / 1e3, nominalPeriod / 1e3, getDriftPPM(), getJitterNs() / 1e3,
+          (unsigned long long) next, (unsigned long long) totalDrains, (unsigned long long) gaps);
+}
@@ -0,0 +1,74 @@
+/* Sensor sample clock reconstruction
+   A sensor that buffers samples (the MPU6050 FIFO, the DMP packet stream)
+   samples on its own oscillator, and the host only sees when it drained
+   them. Back-dating each sample from the drain time by the nominal period
+   carries the bus latency and scheduling jitter of every drain into every
+   timestamp, and lets the few hundred ppm the oscillator is off accumulate.
+
+   SampleClock numbers the samples as they arrive and fits the host drain
+   times against the index of the newest sample drained,
+
+       drainTime(k) = offset + period * lastIndex(k) + delay(k)
+
+   with an exponentially weighted least squares fit, so period tracks the
+   sensor's actual rate (and its temperature drift) in host nanoseconds.
+   delay(k) >= 0 is how long the newest sample waited in the FIFO plus the
+   read itself. A sample is stamped on the lower envelope of the drain
+   times, fit minus the spread of the residuals below it, which is the
+   earliest the sample could have been drained. The result is a straight
+   line in sample index with no per-drain jitter.
+
+   Until the fit has seen enough drains to resolve the period it uses the
+   nominal one, computed from the sensor's rate configuration.
+   A FIFO overflow loses an unknown number of samples; gap() keeps the
+   period, continues the numbering from the elapsed host time and restarts
+   the offset fit.
+*/
+
+#ifndef _SAMPLECLOCK_H_
+#define _SAMPLECLOCK_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Drains weighted into the fit, the weight of older ones decays as exp(-age / window)
+#define SAMPLECLOCK_DEFAULT_WINDOW 1000
+// Drains before the fitted period replaces the nominal one
+#define SAMPLECLOCK_MIN_DRAINS 16
+
+class SampleClock {
+ public:
+    SampleClock(double nominalPeriodNs=0, uint32_t window=SAMPLECLOCK_DEFAULT_WINDOW);
+
+    void reset(double nominalPeriodNs);
+    uint64_t update(uint64_t drainNs, uint32_t count);
+    void gap(uint64_t drainNs);
+    uint64_t timestamp(uint64_t index, uint64_t drainNs);
+
+    double getPeriod() const;
+    double getDriftPPM() const;
+    double getJitterNs() const;
+    uint64_t getDrains() const { return drains; }
+    void printStats(FILE *out, const char *name) const;
+
+ private:
+    double nominalPeriod;
+    double priorPeriod;     // period used until the fit resolves it, nominal or from before a gap
+    double lambda;          // forgetting factor, 1 - 1/window
+
+    uint64_t next;          // index of the next sample to arrive
+    uint64_t drains;        // drains since the last reset or gap
+    uint64_t totalDrains;
+    uint64_t gaps;
+    uint64_t origin;        // host time subtracted from every drain time
+    uint64_t lastStamp;
+
+    // Exponentially weighted sums around the means, x = sample index, y = drain time
+    double weight, meanX, meanY, covXX, covXY;
+    double envelope;        // lowest recent residual below the fit (<= 0)
+    double residualVar;     // weighted variance of the residuals
+
+    double fit(double x) const;
+};
+
+#endif /* _SAMPLECLOCK_H_ */
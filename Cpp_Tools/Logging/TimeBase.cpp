@@ -0,0 +1,46 @@
+// Host time base
+
+#include "TimeBase.h"
+
+static int64_t read_clock(clockid_t clock) {
+  struct timespec ts;
+  clock_gettime(clock, &ts);
+  return (int64_t) ts.tv_sec * 1000000000ll + ts.tv_nsec;
+}
+
+// Offset of clock against a reference clock read on both sides of it
+static uint32_t bracket(clockid_t reference, clockid_t clock, int64_t *referenceNs, int64_t *clockNs) {
+  uint32_t best = UINT32_MAX;
+  for (int i = 0; i < TIMEBASE_PAIR_TRIES; i++) {
+    int64_t before = read_clock(reference);
+    int64_t value = read_clock(clock);
+    int64_t after = read_clock(reference);
+    if ((uint64_t) (after - before) < best) {
+      best = after - before;
+      *referenceNs = before + (after - before) / 2;
+      *clockNs = value;
+    }
+  }
+  return best;
+}
+
+/** Sample the record clock and CLOCK_REALTIME at the same moment.
+ * @param clockNs Record clock time of the pair
+ * @param realtimeNs CLOCK_REALTIME at that moment
+ * @return Uncertainty of the pair in nanoseconds, the width of the raw clock bracket
+ */
+uint32_t TimeBase::samplePair(int64_t *clockNs, int64_t *realtimeNs) {
+  return bracket(TIMEBASE_CLOCK, CLOCK_REALTIME, clockNs, realtimeNs);
+}
+
+/** Convert a CLOCK_MONOTONIC time to the record clock.
+ * The two clocks only differ by the NTP slew accumulated since boot, so the
+ * current offset applies to any recent time.
+ * @param monotonicNs CLOCK_MONOTONIC nanoseconds
+ * @return CLOCK_MONOTONIC_RAW nanoseconds
+ */
+uint64_t TimeBase::fromMonotonic(uint64_t monotonicNs) {
+  int64_t raw, mono;
+  bracket(CLOCK_MONOTONIC, TIMEBASE_CLOCK, &mono, &raw);
+  return monotonicNs + (uint64_t) (raw - mono);
+}
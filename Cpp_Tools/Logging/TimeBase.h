@@ -0,0 +1,44 @@
+/* Host time base
+   All record timestamps are CLOCK_MONOTONIC_RAW nanoseconds. The raw clock
+   never steps and, unlike CLOCK_MONOTONIC, is not slewed by NTP or a GPS
+   discipline daemon, so intervals within a run are measured by the free
+   running crystal and records order correctly whatever the wall clock does.
+
+   Wall time is recovered after the run from (raw, realtime) pairs: one in
+   the log header and one every BINLOG_TIMESYNC_PERIOD_S in the record
+   stream (see BinaryLog). samplePair() reads the realtime clock between two
+   raw reads and keeps the narrowest of a few tries, so a pair is good to
+   well under a microsecond unless the thread was preempted every time.
+
+   Both clocks are read through the vDSO on current kernels, without a
+   system call; Benchmarks/clock_bench checks that on the target.
+   Kernel interfaces that can only stamp CLOCK_MONOTONIC (GPIO edge events,
+   clock_nanosleep) are converted with fromMonotonic().
+*/
+
+#ifndef _TIMEBASE_H_
+#define _TIMEBASE_H_
+
+#include <stdint.h>
+#include <time.h>
+
+#define TIMEBASE_CLOCK CLOCK_MONOTONIC_RAW
+// Reads per samplePair(), the narrowest bracket wins
+#define TIMEBASE_PAIR_TRIES 5
+
+class TimeBase {
+ public:
+    /** Current time on the record time base.
+     * @return CLOCK_MONOTONIC_RAW nanoseconds
+     */
+    static inline uint64_t now() {
+      struct timespec ts;
+      clock_gettime(TIMEBASE_CLOCK, &ts);
+      return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+    }
+
+    static uint32_t samplePair(int64_t *clockNs, int64_t *realtimeNs);
+    static uint64_t fromMonotonic(uint64_t monotonicNs);
+};
+
+#endif /* _TIMEBASE_H_ */
@@ -38,11 +38,14 @@ THE SOFTWARE.
 #define _MPU6050_H_
 
 #include "I2Cdev.h"
+#include "I2CBatch.h"
+#include "I2CRegisterMap.h"
+#include "helper_3dmath.h"
 
 // supporting link:  http://forum.arduino.cc/index.php?&topic=143444.msg1079517#msg1079517
 // also: http://forum.arduino.cc/index.php?&topic=141571.msg1062899#msg1062899s
 
-#ifndef __arm__
+#ifdef __AVR__
 #include <avr/pgmspace.h>
 #else
 #define PROGMEM /* empty */
@@ -429,17 +432,415 @@ THE SOFTWARE.
 
 #define MPU6050_DMP_MEMORY_BANKS        8
 #define MPU6050_DMP_MEMORY_BANK_SIZE    256
-#define MPU6050_DMP_MEMORY_CHUNK_SIZE   16
+// Longest MEM_R_W burst: half a bank, the largest size that tiles a bank within
+// the 255 data bytes of an I2Cdev transfer
+#define MPU6050_DMP_MEMORY_CHUNK_SIZE   128
+
+// The MotionApps 2.0 DMP driver (MPU6050_6Axis_MotionApps20.cpp) is always built. Its
+// firmware image belongs to InvenSense and is not part of this library; it is loaded
+// at run time from a file made by Config_Tools/dmp_firmware, see dmpLoadFirmware()
+#if !defined(MPU6050_INCLUDE_DMP_MOTIONAPPS20) && !defined(MPU6050_INCLUDE_DMP_MOTIONAPPS41)
+#define MPU6050_INCLUDE_DMP_MOTIONAPPS20
+#endif
 
-// note: DMP code memory blocks defined at end of header file
+#define MPU6050_DMP_CODE_SIZE       1929    // dmpMemory[] of MotionApps 2.0
+#define MPU6050_DMP_CONFIG_SIZE     192     // dmpConfig[]
+#define MPU6050_DMP_UPDATES_SIZE    47      // dmpUpdates[]
+#define MPU6050_DMP_PACKET_SIZE     42      // quaternion, gyro and accel, see dmpGetQuaternion()
+#define MPU6050_DMP_MAX_PACKETS     (MPU6050_FIFO_SIZE / MPU6050_DMP_PACKET_SIZE)
+
+// Firmware image file: magic, then the code, config and update set sizes as
+// little-endian 16-bit words, then the three blocks back to back
+#define MPU6050_DMP_FIRMWARE_MAGIC  "MPUDMP20"
+// Environment variable naming the image used when dmpInitialize() finds none loaded
+#define MPU6050_DMP_FIRMWARE_ENV    "MPU6050_DMP_FIRMWARE"
+
+#define MPU6050_FIFO_SIZE           1024
+#define MPU6050_FIFO_FRAME_SIZE     12  // accel XYZ then gyro XYZ, big-endian 16-bit words
+#define MPU6050_FIFO_MAX_FRAMES     (MPU6050_FIFO_SIZE / MPU6050_FIFO_FRAME_SIZE)
+// Interval to drain the FIFO at, well inside the 85ms it takes to fill with
+// accel/gyro frames at 1kHz, or the 240ms it takes with DMP packets at 100Hz
+#define MPU6050_FIFO_DRAIN_NS       10000000ull
+
+// One accel/gyro sample as stored in the FIFO by MPU6050_PROFILE_FIFO_1KHZ
+typedef struct mpu6050_frame {
+    int16_t ax, ay, az;
+    int16_t gx, gy, gz;
+} MPU6050Frame;
+
+// ======== Register map ========
+// One description of the register file: the shadow cache is built from the
+// table, and every field accessor is checked against it at compile time.
+// Only configuration registers that change when written by the host are
+// cacheable. Sensor data, status, FIFO and DMP memory ports always go to the
+// device, as does I2C_SLV4_CTRL, whose SLV4_EN clears itself once the slave 4
+// transfer completes. Self-clearing reset bits are the last column.
+
+constexpr I2CRegisterInfo MPU6050_REGISTER_MAP[] = {
+    { MPU6050_RA_XG_OFFS_TC,         I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_YG_OFFS_TC,         I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_ZG_OFFS_TC,         I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_X_FINE_GAIN,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_Y_FINE_GAIN,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_Z_FINE_GAIN,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_XA_OFFS_H,          I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_XA_OFFS_L_TC,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_YA_OFFS_H,          I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_YA_OFFS_L_TC,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_ZA_OFFS_H,          I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_ZA_OFFS_L_TC,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_SELF_TEST_X,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_SELF_TEST_Y,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_SELF_TEST_Z,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_SELF_TEST_A,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_XG_OFFS_USRH,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_XG_OFFS_USRL,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_YG_OFFS_USRH,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_YG_OFFS_USRL,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_ZG_OFFS_USRH,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_ZG_OFFS_USRL,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_SMPLRT_DIV,         I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_CONFIG,             I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_GYRO_CONFIG,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_ACCEL_CONFIG,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_FF_THR,             I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_FF_DUR,             I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_MOT_THR,            I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_MOT_DUR,            I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_ZRMOT_THR,          I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_ZRMOT_DUR,          I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_FIFO_EN,            I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_MST_CTRL,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV0_ADDR,      I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV0_REG,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV0_CTRL,      I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV1_ADDR,      I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV1_REG,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV1_CTRL,      I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV2_ADDR,      I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV2_REG,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV2_CTRL,      I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV3_ADDR,      I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV3_REG,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV3_CTRL,      I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV4_ADDR,      I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV4_REG,       I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV4_DO,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV4_CTRL,      0,                      0 },
+    { MPU6050_RA_I2C_SLV4_DI,        0,                      0 },
+    { MPU6050_RA_I2C_MST_STATUS,     0,                      0 },
+    { MPU6050_RA_INT_PIN_CFG,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_INT_ENABLE,         I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_DMP_INT_STATUS,     0,                      0 },
+    { MPU6050_RA_INT_STATUS,         0,                      0 },
+    { MPU6050_RA_ACCEL_XOUT_H,       0,                      0 },
+    { MPU6050_RA_ACCEL_XOUT_L,       0,                      0 },
+    { MPU6050_RA_ACCEL_YOUT_H,       0,                      0 },
+    { MPU6050_RA_ACCEL_YOUT_L,       0,                      0 },
+    { MPU6050_RA_ACCEL_ZOUT_H,       0,                      0 },
+    { MPU6050_RA_ACCEL_ZOUT_L,       0,                      0 },
+    { MPU6050_RA_TEMP_OUT_H,         0,                      0 },
+    { MPU6050_RA_TEMP_OUT_L,         0,                      0 },
+    { MPU6050_RA_GYRO_XOUT_H,        0,                      0 },
+    { MPU6050_RA_GYRO_XOUT_L,        0,                      0 },
+    { MPU6050_RA_GYRO_YOUT_H,        0,                      0 },
+    { MPU6050_RA_GYRO_YOUT_L,        0,                      0 },
+    { MPU6050_RA_GYRO_ZOUT_H,        0,                      0 },
+    { MPU6050_RA_GYRO_ZOUT_L,        0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_00,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_01,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_02,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_03,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_04,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_05,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_06,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_07,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_08,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_09,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_10,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_11,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_12,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_13,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_14,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_15,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_16,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_17,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_18,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_19,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_20,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_21,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_22,   0,                      0 },
+    { MPU6050_RA_EXT_SENS_DATA_23,   0,                      0 },
+    { MPU6050_RA_MOT_DETECT_STATUS,  0,                      0 },
+    { MPU6050_RA_I2C_SLV0_DO,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV1_DO,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV2_DO,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_SLV3_DO,        I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_I2C_MST_DELAY_CTRL, I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_SIGNAL_PATH_RESET,  I2C_REGISTER_CACHEABLE, 0x07 }, // GYRO_RESET, ACCEL_RESET, TEMP_RESET
+    { MPU6050_RA_MOT_DETECT_CTRL,    I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_USER_CTRL,          I2C_REGISTER_CACHEABLE, 0x0F }, // DMP_RESET, FIFO_RESET, I2C_MST_RESET, SIG_COND_RESET
+    { MPU6050_RA_PWR_MGMT_1,         I2C_REGISTER_CACHEABLE, 0x80 }, // DEVICE_RESET
+    { MPU6050_RA_PWR_MGMT_2,         I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_BANK_SEL,           0,                      0 },
+    { MPU6050_RA_MEM_START_ADDR,     0,                      0 },
+    { MPU6050_RA_MEM_R_W,            0,                      0 },
+    { MPU6050_RA_DMP_CFG_1,          I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_DMP_CFG_2,          I2C_REGISTER_CACHEABLE, 0 },
+    { MPU6050_RA_FIFO_COUNTH,        0,                      0 },
+    { MPU6050_RA_FIFO_COUNTL,        0,                      0 },
+    { MPU6050_RA_FIFO_R_W,           0,                      0 },
+    { MPU6050_RA_WHO_AM_I,           I2C_REGISTER_CACHEABLE, 0 },
+};
+#define MPU6050_REGISTER_COUNT (sizeof(MPU6050_REGISTER_MAP) / sizeof(I2CRegisterInfo))
+
+// Bit fields by register, e.g. MPU6050Reg::PWR_MGMT_1::CLKSEL. Multi-bit fields
+// read and write right-aligned values, single bits are bool.
+namespace MPU6050Reg {
+    namespace XG_OFFS_TC {
+        typedef I2CFlag<MPU6050_RA_XG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT> PWR_MODE;
+        typedef I2CField<MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH> OFFSET;
+        typedef I2CFlag<MPU6050_RA_XG_OFFS_TC, MPU6050_TC_OTP_BNK_VLD_BIT> OTP_BNK_VLD;
+    }
+    namespace YG_OFFS_TC {
+        typedef I2CFlag<MPU6050_RA_YG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT> PWR_MODE;
+        typedef I2CField<MPU6050_RA_YG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH> OFFSET;
+        typedef I2CFlag<MPU6050_RA_YG_OFFS_TC, MPU6050_TC_OTP_BNK_VLD_BIT> OTP_BNK_VLD;
+    }
+    namespace ZG_OFFS_TC {
+        typedef I2CFlag<MPU6050_RA_ZG_OFFS_TC, MPU6050_TC_PWR_MODE_BIT> PWR_MODE;
+        typedef I2CField<MPU6050_RA_ZG_OFFS_TC, MPU6050_TC_OFFSET_BIT, MPU6050_TC_OFFSET_LENGTH> OFFSET;
+        typedef I2CFlag<MPU6050_RA_ZG_OFFS_TC, MPU6050_TC_OTP_BNK_VLD_BIT> OTP_BNK_VLD;
+    }
+    namespace CONFIG {
+        typedef I2CField<MPU6050_RA_CONFIG, MPU6050_CFG_EXT_SYNC_SET_BIT, MPU6050_CFG_EXT_SYNC_SET_LENGTH> EXT_SYNC_SET;
+        typedef I2CField<MPU6050_RA_CONFIG, MPU6050_CFG_DLPF_CFG_BIT, MPU6050_CFG_DLPF_CFG_LENGTH> DLPF_CFG;
+    }
+    namespace GYRO_CONFIG {
+        typedef I2CField<MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH> FS_SEL;
+    }
+    namespace ACCEL_CONFIG {
+        typedef I2CFlag<MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_XA_ST_BIT> XA_ST;
+        typedef I2CFlag<MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_YA_ST_BIT> YA_ST;
+        typedef I2CFlag<MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ZA_ST_BIT> ZA_ST;
+        typedef I2CField<MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH> AFS_SEL;
+        typedef I2CField<MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_ACCEL_HPF_BIT, MPU6050_ACONFIG_ACCEL_HPF_LENGTH> ACCEL_HPF;
+    }
+    namespace FIFO_EN {
+        typedef I2CFlag<MPU6050_RA_FIFO_EN, MPU6050_TEMP_FIFO_EN_BIT> TEMP_FIFO_EN;
+        typedef I2CFlag<MPU6050_RA_FIFO_EN, MPU6050_XG_FIFO_EN_BIT> XG_FIFO_EN;
+        typedef I2CFlag<MPU6050_RA_FIFO_EN, MPU6050_YG_FIFO_EN_BIT> YG_FIFO_EN;
+        typedef I2CFlag<MPU6050_RA_FIFO_EN, MPU6050_ZG_FIFO_EN_BIT> ZG_FIFO_EN;
+        typedef I2CFlag<MPU6050_RA_FIFO_EN, MPU6050_ACCEL_FIFO_EN_BIT> ACCEL_FIFO_EN;
+        typedef I2CFlag<MPU6050_RA_FIFO_EN, MPU6050_SLV2_FIFO_EN_BIT> SLV2_FIFO_EN;
+        typedef I2CFlag<MPU6050_RA_FIFO_EN, MPU6050_SLV1_FIFO_EN_BIT> SLV1_FIFO_EN;
+        typedef I2CFlag<MPU6050_RA_FIFO_EN, MPU6050_SLV0_FIFO_EN_BIT> SLV0_FIFO_EN;
+    }
+    namespace I2C_MST_CTRL {
+        typedef I2CFlag<MPU6050_RA_I2C_MST_CTRL, MPU6050_MULT_MST_EN_BIT> MULT_MST_EN;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_CTRL, MPU6050_WAIT_FOR_ES_BIT> WAIT_FOR_ES;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_CTRL, MPU6050_SLV_3_FIFO_EN_BIT> SLV_3_FIFO_EN;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_P_NSR_BIT> I2C_MST_P_NSR;
+        typedef I2CField<MPU6050_RA_I2C_MST_CTRL, MPU6050_I2C_MST_CLK_BIT, MPU6050_I2C_MST_CLK_LENGTH> I2C_MST_CLK;
+    }
+    namespace I2C_SLV4_CTRL {
+        typedef I2CFlag<MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_EN_BIT> EN;
+        typedef I2CFlag<MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_INT_EN_BIT> INT_EN;
+        typedef I2CFlag<MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_REG_DIS_BIT> REG_DIS;
+        typedef I2CField<MPU6050_RA_I2C_SLV4_CTRL, MPU6050_I2C_SLV4_MST_DLY_BIT, MPU6050_I2C_SLV4_MST_DLY_LENGTH> MST_DLY;
+    }
+    namespace I2C_MST_STATUS {
+        typedef I2CFlag<MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_PASS_THROUGH_BIT> PASS_THROUGH;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_DONE_BIT> I2C_SLV4_DONE;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_LOST_ARB_BIT> I2C_LOST_ARB;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV4_NACK_BIT> I2C_SLV4_NACK;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV3_NACK_BIT> I2C_SLV3_NACK;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV2_NACK_BIT> I2C_SLV2_NACK;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV1_NACK_BIT> I2C_SLV1_NACK;
+        typedef I2CFlag<MPU6050_RA_I2C_MST_STATUS, MPU6050_MST_I2C_SLV0_NACK_BIT> I2C_SLV0_NACK;
+    }
+    namespace INT_PIN_CFG {
+        typedef I2CFlag<MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_LEVEL_BIT> INT_LEVEL;
+        typedef I2CFlag<MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_OPEN_BIT> INT_OPEN;
+        typedef I2CFlag<MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_LATCH_INT_EN_BIT> LATCH_INT_EN;
+        typedef I2CFlag<MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_INT_RD_CLEAR_BIT> INT_RD_CLEAR;
+        typedef I2CFlag<MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_LEVEL_BIT> FSYNC_INT_LEVEL;
+        typedef I2CFlag<MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_FSYNC_INT_EN_BIT> FSYNC_INT_EN;
+        typedef I2CFlag<MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT> I2C_BYPASS_EN;
+        typedef I2CFlag<MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_CLKOUT_EN_BIT> CLKOUT_EN;
+    }
+    namespace INT_ENABLE {
+        typedef I2CFlag<MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FF_BIT> FF;
+        typedef I2CFlag<MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_MOT_BIT> MOT;
+        typedef I2CFlag<MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_ZMOT_BIT> ZMOT;
+        typedef I2CFlag<MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_FIFO_OFLOW_BIT> FIFO_OFLOW;
+        typedef I2CFlag<MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_I2C_MST_INT_BIT> I2C_MST_INT;
+        typedef I2CFlag<MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_PLL_RDY_INT_BIT> PLL_RDY_INT;
+        typedef I2CFlag<MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DMP_INT_BIT> DMP_INT;
+        typedef I2CFlag<MPU6050_RA_INT_ENABLE, MPU6050_INTERRUPT_DATA_RDY_BIT> DATA_RDY;
+    }
+    namespace DMP_INT_STATUS {
+        typedef I2CFlag<MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_5_BIT> DMPINT_5;
+        typedef I2CFlag<MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_4_BIT> DMPINT_4;
+        typedef I2CFlag<MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_3_BIT> DMPINT_3;
+        typedef I2CFlag<MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_2_BIT> DMPINT_2;
+        typedef I2CFlag<MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_1_BIT> DMPINT_1;
+        typedef I2CFlag<MPU6050_RA_DMP_INT_STATUS, MPU6050_DMPINT_0_BIT> DMPINT_0;
+    }
+    namespace INT_STATUS {
+        typedef I2CFlag<MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FF_BIT> FF;
+        typedef I2CFlag<MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_MOT_BIT> MOT;
+        typedef I2CFlag<MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_ZMOT_BIT> ZMOT;
+        typedef I2CFlag<MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_FIFO_OFLOW_BIT> FIFO_OFLOW;
+        typedef I2CFlag<MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_I2C_MST_INT_BIT> I2C_MST_INT;
+        typedef I2CFlag<MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_PLL_RDY_INT_BIT> PLL_RDY_INT;
+        typedef I2CFlag<MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DMP_INT_BIT> DMP_INT;
+        typedef I2CFlag<MPU6050_RA_INT_STATUS, MPU6050_INTERRUPT_DATA_RDY_BIT> DATA_RDY;
+    }
+    namespace MOT_DETECT_STATUS {
+        typedef I2CFlag<MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XNEG_BIT> MOT_XNEG;
+        typedef I2CFlag<MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_XPOS_BIT> MOT_XPOS;
+        typedef I2CFlag<MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YNEG_BIT> MOT_YNEG;
+        typedef I2CFlag<MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_YPOS_BIT> MOT_YPOS;
+        typedef I2CFlag<MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZNEG_BIT> MOT_ZNEG;
+        typedef I2CFlag<MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZPOS_BIT> MOT_ZPOS;
+        typedef I2CFlag<MPU6050_RA_MOT_DETECT_STATUS, MPU6050_MOTION_MOT_ZRMOT_BIT> MOT_ZRMOT;
+    }
+    namespace I2C_MST_DELAY_CTRL {
+        typedef I2CFlag<MPU6050_RA_I2C_MST_DELAY_CTRL, MPU6050_DELAYCTRL_DELAY_ES_SHADOW_BIT> DELAY_ES_SHADOW;
+    }
+    namespace SIGNAL_PATH_RESET {
+        typedef I2CFlag<MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_GYRO_RESET_BIT> GYRO_RESET;
+        typedef I2CFlag<MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_ACCEL_RESET_BIT> ACCEL_RESET;
+        typedef I2CFlag<MPU6050_RA_SIGNAL_PATH_RESET, MPU6050_PATHRESET_TEMP_RESET_BIT> TEMP_RESET;
+    }
+    namespace MOT_DETECT_CTRL {
+        typedef I2CField<MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_ACCEL_ON_DELAY_BIT, MPU6050_DETECT_ACCEL_ON_DELAY_LENGTH> ACCEL_ON_DELAY;
+        typedef I2CField<MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_FF_COUNT_BIT, MPU6050_DETECT_FF_COUNT_LENGTH> FF_COUNT;
+        typedef I2CField<MPU6050_RA_MOT_DETECT_CTRL, MPU6050_DETECT_MOT_COUNT_BIT, MPU6050_DETECT_MOT_COUNT_LENGTH> MOT_COUNT;
+    }
+    namespace USER_CTRL {
+        typedef I2CFlag<MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_DMP_EN_BIT> DMP_EN;
+        typedef I2CFlag<MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_EN_BIT> FIFO_EN;
+        typedef I2CFlag<MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT> I2C_MST_EN;
+        typedef I2CFlag<MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_IF_DIS_BIT> I2C_IF_DIS;
+        typedef I2CFlag<MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_DMP_RESET_BIT> DMP_RESET;
+        typedef I2CFlag<MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_FIFO_RESET_BIT> FIFO_RESET;
+        typedef I2CFlag<MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_RESET_BIT> I2C_MST_RESET;
+        typedef I2CFlag<MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_SIG_COND_RESET_BIT> SIG_COND_RESET;
+    }
+    namespace PWR_MGMT_1 {
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_DEVICE_RESET_BIT> DEVICE_RESET;
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT> SLEEP;
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CYCLE_BIT> CYCLE;
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_TEMP_DIS_BIT> TEMP_DIS;
+        typedef I2CField<MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH> CLKSEL;
+    }
+    namespace PWR_MGMT_2 {
+        typedef I2CField<MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_LP_WAKE_CTRL_BIT, MPU6050_PWR2_LP_WAKE_CTRL_LENGTH> LP_WAKE_CTRL;
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XA_BIT> STBY_XA;
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YA_BIT> STBY_YA;
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZA_BIT> STBY_ZA;
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_XG_BIT> STBY_XG;
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_YG_BIT> STBY_YG;
+        typedef I2CFlag<MPU6050_RA_PWR_MGMT_2, MPU6050_PWR2_STBY_ZG_BIT> STBY_ZG;
+    }
+    namespace WHO_AM_I {
+        typedef I2CField<MPU6050_RA_WHO_AM_I, MPU6050_WHO_AM_I_BIT, MPU6050_WHO_AM_I_LENGTH> WHO_AM_I;
+    }
+}
+
+// Registers set by a configuration profile, in ascending order. applyProfile()
+// writes each run of consecutive addresses as one burst, so PWR_MGMT_1 (clock
+// source and wake-up) goes last, after the sensor is configured.
+#define MPU6050_PROFILE_REGISTERS   9
+constexpr uint8_t MPU6050_PROFILE_MAP[MPU6050_PROFILE_REGISTERS] = {
+    MPU6050_RA_SMPLRT_DIV, MPU6050_RA_CONFIG, MPU6050_RA_GYRO_CONFIG, MPU6050_RA_ACCEL_CONFIG,
+    MPU6050_RA_FIFO_EN, MPU6050_RA_INT_PIN_CFG, MPU6050_RA_INT_ENABLE,
+    MPU6050_RA_USER_CTRL, MPU6050_RA_PWR_MGMT_1 };
+
+// Complete register image of a startup configuration, see applyProfile()
+typedef struct mpu6050_profile {
+    const char *name;
+    uint8_t values[MPU6050_PROFILE_REGISTERS];  // in MPU6050_PROFILE_MAP order
+} MPU6050Profile;
+
+/** Build a profile at compile time.
+ * @param clock MPU6050_CLOCK_*
+ * @param gyroRange MPU6050_GYRO_FS_*
+ * @param accelRange MPU6050_ACCEL_FS_*
+ * @param dlpf MPU6050_DLPF_BW_*
+ * @param rateDivider Sample rate is the gyro output rate / (1 + rateDivider)
+ * @param fifo Accel and gyro samples go to the FIFO, which is reset and started
+ * @param intPinConfig INT_PIN_CFG value
+ * @param intEnable INT_ENABLE value
+ */
+constexpr MPU6050Profile mpu6050Profile(const char *name, uint8_t clock, uint8_t gyroRange, uint8_t accelRange,
+                                        uint8_t dlpf, uint8_t rateDivider, bool fifo,
+                                        uint8_t intPinConfig, uint8_t intEnable) {
+    return { name, {
+        rateDivider,
+        dlpf,
+        MPU6050Reg::GYRO_CONFIG::FS_SEL::encode(gyroRange),
+        MPU6050Reg::ACCEL_CONFIG::AFS_SEL::encode(accelRange),
+        (uint8_t) (MPU6050Reg::FIFO_EN::XG_FIFO_EN::encode(fifo) | MPU6050Reg::FIFO_EN::YG_FIFO_EN::encode(fifo) |
+                   MPU6050Reg::FIFO_EN::ZG_FIFO_EN::encode(fifo) | MPU6050Reg::FIFO_EN::ACCEL_FIFO_EN::encode(fifo)),
+        intPinConfig,
+        (uint8_t) (intEnable | MPU6050Reg::INT_ENABLE::FIFO_OFLOW::encode(fifo)),
+        (uint8_t) (MPU6050Reg::USER_CTRL::FIFO_EN::encode(fifo) | MPU6050Reg::USER_CTRL::FIFO_RESET::encode(fifo)),
+        MPU6050Reg::PWR_MGMT_1::CLKSEL::encode(clock) } };  // SLEEP clear
+}
+
+// +-2g, +-250deg/s at 1kHz with the 256Hz DLPF (8kHz gyro rate / 8), polled
+constexpr MPU6050Profile MPU6050_PROFILE_POLLED_1KHZ = mpu6050Profile(
+    "polled 1kHz", MPU6050_CLOCK_PLL_XGYRO, MPU6050_GYRO_FS_250, MPU6050_ACCEL_FS_2,
+    MPU6050_DLPF_BW_256, 7, false, 0x00, 0x00);
+// As above, buffered in the FIFO (see readFIFOFrames())
+constexpr MPU6050Profile MPU6050_PROFILE_FIFO_1KHZ = mpu6050Profile(
+    "FIFO 1kHz", MPU6050_CLOCK_PLL_XGYRO, MPU6050_GYRO_FS_250, MPU6050_ACCEL_FS_2,
+    MPU6050_DLPF_BW_256, 7, true, 0x00, 0x00);
+// As above, with a 50us active-high push-pull INT pulse on every new sample
+constexpr MPU6050Profile MPU6050_PROFILE_DATA_READY_1KHZ = mpu6050Profile(
+    "data ready 1kHz", MPU6050_CLOCK_PLL_XGYRO, MPU6050_GYRO_FS_250, MPU6050_ACCEL_FS_2,
+    MPU6050_DLPF_BW_256, 7, false, 0x00, 1 << MPU6050_INTERRUPT_DATA_RDY_BIT);
 
 class MPU6050 {
     public:
         MPU6050();
         MPU6050(uint8_t address);
+        MPU6050(I2CBus *bus, uint8_t address = MPU6050_DEFAULT_ADDRESS);
+        ~MPU6050();
 
         void initialize();
         bool testConnection();
+        bool applyProfile(const MPU6050Profile &profile);
+
+        // Typed access to the fields in MPU6050Reg, see I2CRegisterMap.h
+        template <typename F>
+        typename F::Type readField() {
+            static_assert(i2cRegisterDescribed(MPU6050_REGISTER_MAP, MPU6050_REGISTER_COUNT, F::reg),
+                          "register missing from MPU6050_REGISTER_MAP");
+            typename F::Type value = typename F::Type();
+            i2cReadField<F>(bus, devAddr, &value);
+            return value;
+        }
+        template <typename F>
+        bool writeField(typename F::Type value) {
+            static_assert(i2cRegisterDescribed(MPU6050_REGISTER_MAP, MPU6050_REGISTER_COUNT, F::reg),
+                          "register missing from MPU6050_REGISTER_MAP");
+            return i2cWriteField<F>(bus, devAddr, value);
+        }
+        // Several fields of one register in a single write
+        template <uint8_t Reg>
+        bool writeFields(const I2CRegisterUpdate<Reg> &update) {
+            static_assert(i2cRegisterDescribed(MPU6050_REGISTER_MAP, MPU6050_REGISTER_COUNT, Reg),
+                          "register missing from MPU6050_REGISTER_MAP");
+            return update.write(bus, devAddr);
+        }
+
+        // register shadow cache
+        void invalidateRegisterCache();
+        bool resyncRegisterCache();
 
         // AUX_VDDIO register
         uint8_t getAuxVDDIOLevel();
@@ -448,6 +849,7 @@ class MPU6050 {
         // SMPLRT_DIV register
         uint8_t getRate();
         void setRate(uint8_t rate);
+        float getSampleRate();
 
         // CONFIG register
         uint8_t getExternalFrameSync();
@@ -621,6 +1023,8 @@ class MPU6050 {
 
         // ACCEL_*OUT_* registers
         void getMotion6(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz);
+        int addMotion6(I2CBatch *batch);
+        void getBatchedMotion6(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz);
         void getAcceleration(int16_t* x, int16_t* y, int16_t* z);
         int16_t getAccelerationX();
         int16_t getAccelerationY();
@@ -716,6 +1120,11 @@ class MPU6050 {
         uint8_t getFIFOByte();
         void setFIFOByte(uint8_t data);
         void getFIFOBytes(uint8_t *data, uint8_t length);
+        bool getFIFOBlock(uint8_t *data, uint16_t length);
+
+        // FIFO burst acquisition
+        void endFIFOAcquisition();
+        uint16_t readFIFOFrames(MPU6050Frame *frames, uint16_t maxFrames, bool *overflow);
 
         // WHO_AM_I register
         uint8_t getDeviceID();
@@ -806,6 +1215,7 @@ class MPU6050 {
         uint8_t readMemoryByte();
         void writeMemoryByte(uint8_t data);
         void readMemoryBlock(uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0);
+        bool readMemoryChecksum(uint16_t dataSize, uint8_t bank, uint8_t address, uint32_t *crc);
         bool writeMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true, bool useProgMem=false);
         bool writeProgMemoryBlock(const uint8_t *data, uint16_t dataSize, uint8_t bank=0, uint8_t address=0, bool verify=true);
 
@@ -825,7 +1235,11 @@ class MPU6050 {
             uint8_t *dmpPacketBuffer;
             uint16_t dmpPacketSize;
 
+            static bool dmpLoadFirmware(const char *path);
+            static bool dmpFirmwareLoaded();
             uint8_t dmpInitialize();
+            uint32_t dmpGetUploadTime();
+            uint16_t dmpReadPackets(uint8_t *packets, uint16_t maxPackets, bool *overflow);
             bool dmpPacketAvailable();
 
             uint8_t dmpSetFIFORate(uint8_t fifoRate);
@@ -1024,8 +1438,15 @@ class MPU6050 {
         #endif
 
     private:
+        I2CBus *bus;
         uint8_t devAddr;
         uint8_t buffer[14];
+        uint8_t motionBuffer[14];   // filled by an I2CBatch, see addMotion6()
+        I2CRegisterCache registerCache;
+        #ifdef MPU6050_INCLUDE_DMP_MOTIONAPPS20
+            uint8_t dmpPacket[MPU6050_DMP_PACKET_SIZE];
+            uint32_t dmpUploadTime;
+        #endif
 };
 
 #endif /* _MPU6050_H_ */
@@ -0,0 +1,474 @@
+// I2Cdev library collection - MPU6050 I2C device class, 6-axis MotionApps 2.0 implementation
+// Based on InvenSense MPU-6050 register map document rev. 2.0, 5/19/2011 (RM-MPU-6000A-00)
+// Based on Arduino's I2Cdev by Jeff Rowberg <jeff@rowberg.net>
+//
+// The DMP firmware itself (dmpMemory, dmpConfig and dmpUpdates in the Arduino
+// MPU6050_6Axis_MotionApps20.h) is not redistributed here. Config_Tools/dmp_firmware
+// extracts it from that header into an image file which dmpLoadFirmware() reads.
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#include "MPU6050.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+
+#ifdef MPU6050_INCLUDE_DMP_MOTIONAPPS20
+
+// FIFO rate divider in DMP memory (D_0_22, inv_set_fifo_rate); output rate is 200Hz / (1 + divider)
+#define DMP_FIFO_RATE_BANK      0x02
+#define DMP_FIFO_RATE_ADDRESS   0x16
+#define DMP_BASE_RATE_HZ        200
+// Polls of FIFO_COUNT while waiting for the DMP to produce its first packets
+#define DMP_START_POLLS         100
+
+// Firmware image shared by all MPU6050 objects
+static uint8_t dmpMemory[MPU6050_DMP_MEMORY_BANKS * MPU6050_DMP_MEMORY_BANK_SIZE];
+static uint8_t dmpConfig[MPU6050_DMP_MEMORY_BANK_SIZE];
+static uint8_t dmpUpdates[MPU6050_DMP_MEMORY_BANK_SIZE];
+static uint16_t dmpCodeSize, dmpConfigSize, dmpUpdatesSize;
+
+/** Load a MotionApps 2.0 firmware image made by Config_Tools/dmp_firmware.
+ * @param path Image file
+ * @return True if the image was read and has the expected layout
+ * @see MPU6050_DMP_FIRMWARE_MAGIC
+ */
+bool MPU6050::dmpLoadFirmware(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return false;
+    }
+    char magic[8];
+    uint8_t sizes[6];
+    bool ok = fread(magic, sizeof(magic), 1, file) == 1 &&
+              memcmp(magic, MPU6050_DMP_FIRMWARE_MAGIC, sizeof(magic)) == 0 &&
+              fread(sizes, sizeof(sizes), 1, file) == 1;
+    if (ok) {
+        dmpCodeSize = sizes[0] | sizes[1] << 8;
+        dmpConfigSize = sizes[2] | sizes[3] << 8;
+        dmpUpdatesSize = sizes[4] | sizes[5] << 8;
+        ok = dmpCodeSize > 0 && dmpCodeSize <= sizeof(dmpMemory) &&
+             dmpConfigSize <= sizeof(dmpConfig) && dmpUpdatesSize <= sizeof(dmpUpdates) &&
+             fread(dmpMemory, dmpCodeSize, 1, file) == 1 &&
+             fread(dmpConfig, 1, dmpConfigSize, file) == dmpConfigSize &&
+             fread(dmpUpdates, 1, dmpUpdatesSize, file) == dmpUpdatesSize;
+    }
+    fclose(file);
+    if (!ok) {
+        fprintf(stderr, "%s is not a MotionApps 2.0 firmware image\n", path);
+        dmpCodeSize = 0;
+    } else if (dmpCodeSize != MPU6050_DMP_CODE_SIZE || dmpConfigSize != MPU6050_DMP_CONFIG_SIZE ||
+               dmpUpdatesSize != MPU6050_DMP_UPDATES_SIZE) {
+        fprintf(stderr, "%s: unexpected block sizes %u/%u/%u, continuing anyway\n",
+                path, dmpCodeSize, dmpConfigSize, dmpUpdatesSize);
+    }
+    return ok;
+}
+
+bool MPU6050::dmpFirmwareLoaded() {
+    return dmpCodeSize > 0;
+}
+
+// Copy the next [bank] [address] [length] [data...] entry of the update set
+static bool nextDMPUpdate(uint16_t *pos, uint8_t *update) {
+    if (*pos + 3 > dmpUpdatesSize || *pos + 3 + dmpUpdates[*pos + 2] > dmpUpdatesSize)
+        return false;
+    uint16_t length = 3 + dmpUpdates[*pos + 2];
+    memcpy(update, dmpUpdates + *pos, length);
+    *pos += length;
+    return true;
+}
+
+/** Upload and configure the MotionApps 2.0 DMP, leaving it stopped.
+ * Uses the image from dmpLoadFirmware(), or the file named by
+ * MPU6050_DMP_FIRMWARE_ENV if none was loaded. Afterwards the DMP is started
+ * with setDMPEnabled(true) and emits one MPU6050_DMP_PACKET_SIZE packet
+ * into the FIFO per output sample (100Hz unless changed with dmpSetFIFORate()).
+ * Gyro range is set to +/- 2000 deg/s and the sample rate to 200Hz.
+ * @return 0 on success, 1 if the firmware could not be loaded or verified,
+ *         2 if the configuration could not be written, 3 if the DMP did not start
+ */
+uint8_t MPU6050::dmpInitialize() {
+    if (!dmpFirmwareLoaded()) {
+        const char *path = getenv(MPU6050_DMP_FIRMWARE_ENV);
+        if (path == NULL) {
+            fprintf(stderr, "No DMP firmware loaded and %s is not set\n", MPU6050_DMP_FIRMWARE_ENV);
+            return 1;
+        }
+        if (!dmpLoadFirmware(path))
+            return 1;
+    }
+
+    // reset device
+    reset();
+    usleep(30000); // wait after reset
+    invalidateRegisterCache();
+
+    // disable sleep mode
+    setSleepEnabled(false);
+
+    // get MPU hardware revision (not used, but the read is part of the documented sequence)
+    setMemoryBank(0x10, true, true);
+    setMemoryStartAddress(0x06);
+    readMemoryByte();
+    setMemoryBank(0, false, false);
+
+    // get X/Y/Z gyro offsets, restored after the firmware clears them
+    int8_t xgOffsetTC = getXGyroOffsetTC();
+    int8_t ygOffsetTC = getYGyroOffsetTC();
+    int8_t zgOffsetTC = getZGyroOffsetTC();
+
+    // setup weird slave stuff (?)
+    setSlaveAddress(0, 0x7F);
+    setI2CMasterModeEnabled(false);
+    setSlaveAddress(0, 0x68);
+    resetI2CMaster();
+    usleep(20000);
+
+    // load DMP code into memory banks and write the DMP configuration,
+    // each verified by a single readback
+    struct timespec uploadStart, uploadEnd;
+    clock_gettime(CLOCK_MONOTONIC, &uploadStart);
+    if (!writeMemoryBlock(dmpMemory, dmpCodeSize))
+        return 1;
+    if (!writeDMPConfigurationSet(dmpConfig, dmpConfigSize))
+        return 2;
+    clock_gettime(CLOCK_MONOTONIC, &uploadEnd);
+    dmpUploadTime = (uploadEnd.tv_sec - uploadStart.tv_sec) * 1000000 +
+                    (uploadEnd.tv_nsec - uploadStart.tv_nsec) / 1000;
+
+    setClockSource(MPU6050_CLOCK_PLL_ZGYRO);
+    setIntEnabled(0x12); // FIFO overflow and DMP interrupts
+    setRate(4); // 1khz / (1 + 4) = 200 Hz
+    setExternalFrameSync(MPU6050_EXT_SYNC_TEMP_OUT_L);
+    setDLPFMode(MPU6050_DLPF_BW_42);
+    setFullScaleGyroRange(MPU6050_GYRO_FS_2000);
+    setDMPConfig1(0x03); // DMP program start address 0x0300
+    setDMPConfig2(0x00);
+    setOTPBankValid(false);
+    setXGyroOffsetTC(xgOffsetTC);
+    setYGyroOffsetTC(ygOffsetTC);
+    setZGyroOffsetTC(zgOffsetTC);
+
+    // The update set holds seven memory patches. Their purpose is undocumented;
+    // the order and the interleaved FIFO reads follow the InvenSense sequence.
+    uint8_t update[3 + 255];
+    uint8_t fifoBuffer[MPU6050_FIFO_SIZE];
+    uint16_t pos = 0, fifoCount;
+    for (uint8_t n = 0; n < 2; n++) {
+        if (!nextDMPUpdate(&pos, update))
+            return 2;
+        writeMemoryBlock(update + 3, update[2], update[0], update[1]);
+    }
+
+    resetFIFO();
+    setMotionDetectionThreshold(2);
+    setZeroMotionDetectionThreshold(156);
+    setMotionDetectionDuration(80);
+    setZeroMotionDetectionDuration(0);
+    resetFIFO();
+    setFIFOEnabled(true);
+    setDMPEnabled(true);
+    resetDMP();
+
+    for (uint8_t n = 0; n < 3; n++) {
+        if (!nextDMPUpdate(&pos, update))
+            return 2;
+        writeMemoryBlock(update + 3, update[2], update[0], update[1]);
+    }
+
+    for (uint8_t n = 0; n < 2; n++) {
+        // wait for the DMP to produce output, then discard it
+        uint8_t polls = 0;
+        while ((fifoCount = getFIFOCount()) < 3 || fifoCount > MPU6050_FIFO_SIZE) {
+            if (++polls > DMP_START_POLLS) {
+                setDMPEnabled(false);
+                return 3;
+            }
+            usleep(1000);
+        }
+        getFIFOBlock(fifoBuffer, fifoCount);
+        getIntStatus();
+
+        if (!nextDMPUpdate(&pos, update))
+            return 2;
+        if (n == 0)
+            readMemoryBlock(update + 3, update[2], update[0], update[1]);
+        else
+            writeMemoryBlock(update + 3, update[2], update[0], update[1]);
+    }
+
+    setDMPEnabled(false);
+    dmpPacketSize = MPU6050_DMP_PACKET_SIZE;
+    resetFIFO();
+    getIntStatus();
+    return 0;
+}
+
+/** Duration of the firmware upload in the last successful dmpInitialize(),
+ * covering the code and configuration writes and their verification.
+ * @return Microseconds, 0 before the first upload
+ */
+uint32_t MPU6050::dmpGetUploadTime() {
+    return dmpUploadTime;
+}
+
+/** Check whether at least one complete DMP packet is waiting in the FIFO.
+ */
+bool MPU6050::dmpPacketAvailable() {
+    return getFIFOCount() >= dmpGetFIFOPacketSize();
+}
+
+/** Set the DMP output rate divider.
+ * @param fifoRate Divider of the 200Hz DMP rate: 0 = 200Hz, 1 = 100Hz, 9 = 20Hz
+ * @return 0 on success
+ */
+uint8_t MPU6050::dmpSetFIFORate(uint8_t fifoRate) {
+    uint8_t rate[2] = { 0x00, fifoRate };
+    return writeMemoryBlock(rate, 2, DMP_FIFO_RATE_BANK, DMP_FIFO_RATE_ADDRESS) ? 0 : 1;
+}
+
+uint8_t MPU6050::dmpGetFIFORate() {
+    uint8_t rate[2];
+    readMemoryBlock(rate, 2, DMP_FIFO_RATE_BANK, DMP_FIFO_RATE_ADDRESS);
+    return rate[1];
+}
+
+uint8_t MPU6050::dmpGetSampleFrequency() {
+    return DMP_BASE_RATE_HZ / (1 + dmpGetFIFORate());
+}
+
+uint8_t MPU6050::dmpGetSampleStepSizeMS() {
+    return 1000 / dmpGetSampleFrequency();
+}
+
+uint16_t MPU6050::dmpGetFIFOPacketSize() {
+    return dmpPacketSize ? dmpPacketSize : MPU6050_DMP_PACKET_SIZE;
+}
+
+/** Drain whole DMP packets from the FIFO.
+ * Same contract as readFIFOFrames(): every complete packet (up to maxPackets)
+ * is fetched with a single block read, and on overflow or a failed read the
+ * FIFO is reset and overflow is set.
+ * @param packets Buffer of maxPackets * dmpGetFIFOPacketSize() bytes, oldest first
+ * @param maxPackets Capacity of packets
+ * @param overflow Set to true if packets were lost since the previous call
+ * @return Number of packets stored
+ */
+uint16_t MPU6050::dmpReadPackets(uint8_t *packets, uint16_t maxPackets, bool *overflow) {
+    *overflow = false;
+    uint16_t packetSize = dmpGetFIFOPacketSize();
+    uint8_t status = getIntStatus();
+    uint16_t count = getFIFOCount();
+    if ((status & (1 << MPU6050_INTERRUPT_FIFO_OFLOW_BIT)) || count >= MPU6050_FIFO_SIZE) {
+        resetFIFO();
+        *overflow = true;
+        return 0;
+    }
+
+    uint16_t available = count / packetSize;
+    if (available > maxPackets) available = maxPackets;
+    if (available == 0)
+        return 0;
+    if (!getFIFOBlock(packets, available * packetSize)) {
+        resetFIFO();
+        *overflow = true;
+        return 0;
+    }
+    return available;
+}
+
+// Packet layout: quaternion w, x, y, z (bytes 0-15), gyro x, y, z (16-27) and
+// accel x, y, z (28-39) as big-endian 32-bit words, then 2 bytes of unknown use.
+// The 16-bit accessors return the upper half of each word.
+
+static int32_t packetLong(const uint8_t *packet, uint8_t offset) {
+    return ((uint32_t) packet[offset] << 24) | ((uint32_t) packet[offset + 1] << 16) |
+           ((uint32_t) packet[offset + 2] << 8) | packet[offset + 3];
+}
+
+static int16_t packetWord(const uint8_t *packet, uint8_t offset) {
+    return (int16_t) ((packet[offset] << 8) | packet[offset + 1]);
+}
+
+uint8_t MPU6050::dmpGetAccel(int32_t *data, const uint8_t* packet) {
+    if (packet == 0) packet = dmpPacketBuffer;
+    if (packet == 0) return 1;
+    data[0] = packetLong(packet, 28);
+    data[1] = packetLong(packet, 32);
+    data[2] = packetLong(packet, 36);
+    return 0;
+}
+uint8_t MPU6050::dmpGetAccel(int16_t *data, const uint8_t* packet) {
+    if (packet == 0) packet = dmpPacketBuffer;
+    if (packet == 0) return 1;
+    data[0] = packetWord(packet, 28);
+    data[1] = packetWord(packet, 32);
+    data[2] = packetWord(packet, 36);
+    return 0;
+}
+uint8_t MPU6050::dmpGetAccel(VectorInt16 *v, const uint8_t* packet) {
+    if (packet == 0) packet = dmpPacketBuffer;
+    if (packet == 0) return 1;
+    v->x = packetWord(packet, 28);
+    v->y = packetWord(packet, 32);
+    v->z = packetWord(packet, 36);
+    return 0;
+}
+
+uint8_t MPU6050::dmpGetQuaternion(int32_t *data, const uint8_t* packet) {
+    if (packet == 0) packet = dmpPacketBuffer;
+    if (packet == 0) return 1;
+    data[0] = packetLong(packet, 0);
+    data[1] = packetLong(packet, 4);
+    data[2] = packetLong(packet, 8);
+    data[3] = packetLong(packet, 12);
+    return 0;
+}
+/** Unit quaternion in Q14 fixed point (16384 = 1.0), w, x, y, z.
+ */
+uint8_t MPU6050::dmpGetQuaternion(int16_t *data, const uint8_t* packet) {
+    if (packet == 0) packet = dmpPacketBuffer;
+    if (packet == 0) return 1;
+    data[0] = packetWord(packet, 0);
+    data[1] = packetWord(packet, 4);
+    data[2] = packetWord(packet, 8);
+    data[3] = packetWord(packet, 12);
+    return 0;
+}
+uint8_t MPU6050::dmpGetQuaternion(Quaternion *q, const uint8_t* packet) {
+    int16_t qI[4];
+    uint8_t status = dmpGetQuaternion(qI, packet);
+    if (status == 0) {
+        q->w = (float) qI[0] / 16384.0f;
+        q->x = (float) qI[1] / 16384.0f;
+        q->y = (float) qI[2] / 16384.0f;
+        q->z = (float) qI[3] / 16384.0f;
+    }
+    return status;
+}
+
+uint8_t MPU6050::dmpGetGyro(int32_t *data, const uint8_t* packet) {
+    if (packet == 0) packet = dmpPacketBuffer;
+    if (packet == 0) return 1;
+    data[0] = packetLong(packet, 16);
+    data[1] = packetLong(packet, 20);
+    data[2] = packetLong(packet, 24);
+    return 0;
+}
+uint8_t MPU6050::dmpGetGyro(int16_t *data, const uint8_t* packet) {
+    if (packet == 0) packet = dmpPacketBuffer;
+    if (packet == 0) return 1;
+    data[0] = packetWord(packet, 16);
+    data[1] = packetWord(packet, 20);
+    data[2] = packetWord(packet, 24);
+    return 0;
+}
+uint8_t MPU6050::dmpGetGyro(VectorInt16 *v, const uint8_t* packet) {
+    if (packet == 0) packet = dmpPacketBuffer;
+    if (packet == 0) return 1;
+    v->x = packetWord(packet, 16);
+    v->y = packetWord(packet, 20);
+    v->z = packetWord(packet, 24);
+    return 0;
+}
+
+/** Remove gravity from a raw accel reading.
+ * @param v Linear acceleration in sensor frame
+ * @param vRaw Accel from dmpGetAccel(), 8192 LSB/g
+ * @param gravity Unit gravity vector from dmpGetGravity()
+ */
+uint8_t MPU6050::dmpGetLinearAccel(VectorInt16 *v, VectorInt16 *vRaw, VectorFloat *gravity) {
+    v->x = vRaw->x - gravity->x*8192;
+    v->y = vRaw->y - gravity->y*8192;
+    v->z = vRaw->z - gravity->z*8192;
+    return 0;
+}
+
+/** Rotate linear acceleration from the sensor frame into the world frame.
+ */
+uint8_t MPU6050::dmpGetLinearAccelInWorld(VectorInt16 *v, VectorInt16 *vReal, Quaternion *q) {
+    *v = vReal->getRotated(q);
+    return 0;
+}
+
+/** Gravity direction in the sensor frame, derived from the attitude quaternion.
+ */
+uint8_t MPU6050::dmpGetGravity(VectorFloat *v, Quaternion *q) {
+    v->x = 2 * (q->x*q->z - q->w*q->y);
+    v->y = 2 * (q->w*q->x + q->y*q->z);
+    v->z = q->w*q->w - q->x*q->x - q->y*q->y + q->z*q->z;
+    return 0;
+}
+
+/** Euler angles psi, theta, phi in radians.
+ */
+uint8_t MPU6050::dmpGetEuler(float *data, Quaternion *q) {
+    data[0] = atan2(2*q->x*q->y - 2*q->w*q->z, 2*q->w*q->w + 2*q->x*q->x - 1);   // psi
+    data[1] = -asin(2*q->x*q->z + 2*q->w*q->y);                              // theta
+    data[2] = atan2(2*q->y*q->z - 2*q->w*q->x, 2*q->w*q->w + 2*q->z*q->z - 1);   // phi
+    return 0;
+}
+
+/** Yaw, pitch and roll in radians, pitch and roll taken from the gravity vector.
+ */
+uint8_t MPU6050::dmpGetYawPitchRoll(float *data, Quaternion *q, VectorFloat *gravity) {
+    // yaw: (about Z axis)
+    data[0] = atan2(2*q->x*q->y - 2*q->w*q->z, 2*q->w*q->w + 2*q->x*q->x - 1);
+    // pitch: (nose up/down, about Y axis)
+    data[1] = atan(gravity->x / sqrt(gravity->y*gravity->y + gravity->z*gravity->z));
+    // roll: (tilt left/right, about X axis)
+    data[2] = atan(gravity->y / sqrt(gravity->x*gravity->x + gravity->z*gravity->z));
+    return 0;
+}
+
+/** Make a packet the default source of the dmpGet*() accessors.
+ * @param dmpData One complete packet, must stay valid while it is used
+ */
+uint8_t MPU6050::dmpProcessFIFOPacket(const unsigned char *dmpData) {
+    dmpPacketBuffer = (uint8_t *) dmpData;
+    return 0;
+}
+
+/** Read packets one at a time and process each, leaving the last one current.
+ * Prefer dmpReadPackets(), which fetches everything in a single transfer.
+ * @param numPackets Packets to read
+ * @param processed Set to the number of packets processed
+ * @return 0 on success, 1 if the FIFO held too few packets
+ */
+uint8_t MPU6050::dmpReadAndProcessFIFOPacket(uint8_t numPackets, uint8_t *processed) {
+    uint16_t packetSize = dmpGetFIFOPacketSize();
+    if (processed != NULL) *processed = 0;
+    if (getFIFOCount() < numPackets * packetSize)
+        return 1;
+    for (uint8_t i = 0; i < numPackets; i++) {
+        getFIFOBytes(dmpPacket, packetSize);
+        dmpProcessFIFOPacket(dmpPacket);
+        if (processed != NULL) (*processed)++;
+    }
+    return 0;
+}
+
+#endif /* MPU6050_INCLUDE_DMP_MOTIONAPPS20 */
@@ -0,0 +1,169 @@
+/* I2Cdev library collection - 3D math helper
+   Quaternion and vector types used by the MPU6050 DMP accessors.
+   Based on Arduino's I2Cdev by Jeff Rowberg <jeff@rowberg.net>
+*/
+
+/* ============================================
+I2Cdev device library code is placed under the MIT license
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+===============================================
+*/
+
+#ifndef _HELPER_3DMATH_H_
+#define _HELPER_3DMATH_H_
+
+#include <stdint.h>
+#include <math.h>
+
+class Quaternion {
+    public:
+        float w;
+        float x;
+        float y;
+        float z;
+
+        Quaternion() : w(1.0f), x(0.0f), y(0.0f), z(0.0f) {}
+        Quaternion(float nw, float nx, float ny, float nz) : w(nw), x(nx), y(ny), z(nz) {}
+
+        Quaternion getProduct(Quaternion q) const {
+            // Quaternion multiplication is defined by:
+            //     (Q1 * Q2).w = (w1w2 - x1x2 - y1y2 - z1z2)
+            //     (Q1 * Q2).x = (w1x2 + x1w2 + y1z2 - z1y2)
+            //     (Q1 * Q2).y = (w1y2 - x1z2 + y1w2 + z1x2)
+            //     (Q1 * Q2).z = (w1z2 + x1y2 - y1x2 + z1w2)
+            return Quaternion(
+                w*q.w - x*q.x - y*q.y - z*q.z,
+                w*q.x + x*q.w + y*q.z - z*q.y,
+                w*q.y - x*q.z + y*q.w + z*q.x,
+                w*q.z + x*q.y - y*q.x + z*q.w);
+        }
+
+        Quaternion getConjugate() const {
+            return Quaternion(w, -x, -y, -z);
+        }
+
+        float getMagnitude() const {
+            return sqrtf(w*w + x*x + y*y + z*z);
+        }
+
+        void normalize() {
+            float m = getMagnitude();
+            if (m == 0.0f) return;
+            w /= m;
+            x /= m;
+            y /= m;
+            z /= m;
+        }
+
+        Quaternion getNormalized() const {
+            Quaternion r(w, x, y, z);
+            r.normalize();
+            return r;
+        }
+};
+
+class VectorInt16 {
+    public:
+        int16_t x;
+        int16_t y;
+        int16_t z;
+
+        VectorInt16() : x(0), y(0), z(0) {}
+        VectorInt16(int16_t nx, int16_t ny, int16_t nz) : x(nx), y(ny), z(nz) {}
+
+        float getMagnitude() const {
+            return sqrtf((float) x*x + (float) y*y + (float) z*z);
+        }
+
+        void normalize() {
+            float m = getMagnitude();
+            if (m == 0.0f) return;
+            x /= m;
+            y /= m;
+            z /= m;
+        }
+
+        VectorInt16 getNormalized() const {
+            VectorInt16 r(x, y, z);
+            r.normalize();
+            return r;
+        }
+
+        // Rotate by a unit quaternion: P_out = q * P_in * conj(q)
+        void rotate(const Quaternion *q) {
+            Quaternion p(0, x, y, z);
+            p = q->getProduct(p);
+            p = p.getProduct(q->getConjugate());
+            x = p.x;
+            y = p.y;
+            z = p.z;
+        }
+
+        VectorInt16 getRotated(const Quaternion *q) const {
+            VectorInt16 r(x, y, z);
+            r.rotate(q);
+            return r;
+        }
+};
+
+class VectorFloat {
+    public:
+        float x;
+        float y;
+        float z;
+
+        VectorFloat() : x(0.0f), y(0.0f), z(0.0f) {}
+        VectorFloat(float nx, float ny, float nz) : x(nx), y(ny), z(nz) {}
+
+        float getMagnitude() const {
+            return sqrtf(x*x + y*y + z*z);
+        }
+
+        void normalize() {
+            float m = getMagnitude();
+            if (m == 0.0f) return;
+            x /= m;
+            y /= m;
+            z /= m;
+        }
+
+        VectorFloat getNormalized() const {
+            VectorFloat r(x, y, z);
+            r.normalize();
+            return r;
+        }
+
+        void rotate(const Quaternion *q) {
+            Quaternion p(0, x, y, z);
+            p = q->getProduct(p);
+            p = p.getProduct(q->getConjugate());
+            x = p.x;
+            y = p.y;
+            z = p.z;
+        }
+
+        VectorFloat getRotated(const Quaternion *q) const {
+            VectorFloat r(x, y, z);
+            r.rotate(q);
+            return r;
+        }
+};
+
+#endif /* _HELPER_3DMATH_H_ */
@@ -2,72 +2,321 @@
 #include <stdio.h>
 #include <signal.h>
 #include <time.h>
-#include <sys/time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <pthread.h>
 
-// Libraries for I2C and the MPU6050
+// Libraries for I2C, GPIO and the MPU6050
 #include <bcm2835.h>
 #include "MPU6050.h"
+#include "GPIOLine.h"
+#include "BinaryLog.h"
+#include "SampleClock.h"
+#include "PeriodicTimer.h"
+#include "RealTime.h"
 
 #define PI 3.14159265359
 
+#define IMU_PERIOD_NS 1000000ull
+
 // Signal handler callback function
 volatile sig_atomic_t done = 0;
 void sig_handler(int signum) {
     done = 1;
 }
+
+// SIGUSR1 prints the loop and bus statistics while running
+volatile sig_atomic_t stats_requested = 0;
+void stats_handler(int signum) {
+    stats_requested = 1;
+}
+void print_requested_stats(const PeriodicTimer &timer) {
+    if (!stats_requested)
+        return;
+    stats_requested = 0;
+    timer.printStats(stdout, "MPU6050");
+    I2CStats::print(stdout);
+    fflush(stdout);
+}
+void usage(const char *name) {
+    fprintf(stderr, "Usage: %s [-r] [-f | -i chip:line | -d image | -2]\n"
+                    "  -r             real-time mode: lock memory, SCHED_FIFO on a core of its own\n"
+                    "  -f             buffer samples in the sensor FIFO and drain them in bursts\n"
+                    "  -i chip:line   wait for the data-ready interrupt on a GPIO line, e.g. gpiochip0:17\n"
+                    "  -d image       run the MotionApps 2.0 DMP from a dmp_firmware image and log its\n"
+                    "                 orientation quaternion, \"-\" takes the image from $%s\n"
+                    "  -2             also poll a redundant MPU6050 at 0x69, in the same bus transfer,\n"
+                    "                 into imu2_data_<time>.bin\n",
+            name, MPU6050_DMP_FIRMWARE_ENV);
+}
+
 int main(int argc, char **argv) {
+    bool fifo_mode = false;
+    bool realtime = false;
+    bool redundant = false;
+    char *irq_chip = NULL;
+    const char *dmp_firmware = NULL;
+    uint32_t irq_line = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "rfi:d:2")) != -1) {
+        switch (opt) {
+            case 'r': realtime = true; break;
+            case 'f': fifo_mode = true; break;
+            case 'd': dmp_firmware = optarg; break;
+            case '2': redundant = true; break;
+            case 'i': {
+                char *sep = strrchr(optarg, ':');
+                if (sep == NULL) { usage(argv[0]); return 1; }
+                *sep = '\0';
+                irq_chip = optarg;
+                irq_line = strtoul(sep + 1, NULL, 10);
+                break;
+            }
+            default: usage(argv[0]); return 1;
+        }
+    }
+    if ((fifo_mode + (irq_chip != NULL) + (dmp_firmware != NULL) + redundant) > 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
     // Set up signal handler
     struct sigaction action;
     memset(&action, 0, sizeof(struct sigaction));
     action.sa_handler = sig_handler;
     sigaction(SIGTERM, &action, NULL);
     sigaction(SIGINT, &action, NULL);
+    action.sa_handler = stats_handler;
+    sigaction(SIGUSR1, &action, NULL);
 
     // Create new file with timestamp
     char filename_buffer[255];
+    char filename2_buffer[255];
     time_t t = time(NULL);
     struct tm tm = *localtime(&t);
-    sprintf(filename_buffer, "imu_data_%04d-%02d-%02dT%02d%02d%02d.log", 
+    sprintf(filename_buffer, "imu_data_%04d-%02d-%02dT%02d%02d%02d.bin", 
             tm.tm_year+1900, tm.tm_mon+1, tm.tm_mday, 
             tm.tm_hour, tm.tm_min, tm.tm_sec);
-    FILE *f = fopen(filename_buffer, "w");
-    
-    // Initialize I2C and the sensor itself
+    sprintf(filename2_buffer, "imu2_data_%04d-%02d-%02dT%02d%02d%02d.bin",
+            tm.tm_year+1900, tm.tm_mon+1, tm.tm_mday,
+            tm.tm_hour, tm.tm_min, tm.tm_sec);
+
+    // Real-time mode locks memory before the log buffers are allocated and
+    // leaves core 0 to the log writer thread
+    if (realtime) {
+        RealTime::lockMemory();
+        RealTime::pinThread(pthread_self(), 0);
+    }
+
+    // Raw samples go to a binary log, the scale factors below are stored in its
+    // header and applied by log2csv: acceleration in g's, angular rate in rad/s
     const float accel_scaling = 2.0/32767.0;
     const float gyro_scaling = 250.0/32767.0*PI/180.0;
+    const double scale[6] = { accel_scaling, accel_scaling, accel_scaling,
+                              gyro_scaling, gyro_scaling, gyro_scaling };
+    // The DMP quaternion is Q14 fixed point
+    const double quaternion_scale[4] = { 1.0/16384.0, 1.0/16384.0, 1.0/16384.0, 1.0/16384.0 };
+    BinaryLog log;
+    if (dmp_firmware) {
+        if (!log.open(filename_buffer, BINLOG_DEVICE_MPU6050_DMP, 4, quaternion_scale, 0, "MPU6050 DMP quaternion"))
+            return 1;
+    } else if (!log.open(filename_buffer, BINLOG_DEVICE_MPU6050, 6, scale, 0, "MPU6050 +-2g +-250dps")) {
+        return 1;
+    }
+    BinaryLog log2;
+    if (redundant && !log2.open(filename2_buffer, BINLOG_DEVICE_MPU6050, 6, scale, 0, "MPU6050 0x69 +-2g +-250dps"))
+        return 1;
+    
+    // Initialize I2C and the sensor itself
     I2Cdev::initialize();
     MPU6050 imu;
-    int16_t ax, ay, az;
-    int16_t gx, gy, gz;
+    int16_t sample[6];
     if ( imu.testConnection() ) 
         printf("MPU6050 connection test successful\n") ;
     else {
         fprintf(stderr, "MPU6050 connection test failed! something maybe wrong, continuing anyway though ...\n");
     }
-    imu.initialize();
-    // Set gyro sampling rate to 1kHz
-    imu.setRate(7);
+    // Each mode has a precomputed register image (1kHz, +-2g, +-250deg/s),
+    // the DMP sets the sensor up itself
+    if (!dmp_firmware) {
+        const MPU6050Profile &profile = fifo_mode ? MPU6050_PROFILE_FIFO_1KHZ :
+                                        irq_chip ? MPU6050_PROFILE_DATA_READY_1KHZ :
+                                        MPU6050_PROFILE_POLLED_1KHZ;
+        if (!imu.applyProfile(profile))
+            fprintf(stderr, "MPU6050 %s configuration did not verify, continuing anyway ...\n", profile.name);
+    }
+    // The redundant sensor is read together with the first one, see the polling loop
+    MPU6050 imu2(MPU6050_ADDRESS_AD0_HIGH);
+    int16_t sample2[6];
+    I2CBatch batch;
+    if (redundant) {
+        if (!imu2.testConnection())
+            fprintf(stderr, "MPU6050 at 0x69 connection test failed! continuing anyway though ...\n");
+        if (!imu2.applyProfile(MPU6050_PROFILE_POLLED_1KHZ))
+            fprintf(stderr, "MPU6050 at 0x69 %s configuration did not verify, continuing anyway ...\n",
+                    MPU6050_PROFILE_POLLED_1KHZ.name);
+        imu.addMotion6(&batch);
+        imu2.addMotion6(&batch);
+        log2.setSamplePeriod((uint32_t) (1e9 / imu2.getSampleRate()));
+    }
 
-    // Initialize time
-    struct timeval start_time, current_time;
+    // Monotonic sample times in ns
+    uint64_t start_time, current_time;
+    // Buffered modes reconstruct sample times from the sensor's own clock
+    SampleClock sample_clock;
+    // Polling and draining run on an absolute release grid
+    PeriodicTimer timer(fifo_mode || dmp_firmware ? MPU6050_FIFO_DRAIN_NS : IMU_PERIOD_NS);
+    // Interrupt mode: time from the edge until the thread runs
+    LatencyHistogram irq_wakeup;
+    log.setSamplePeriod((uint32_t) (1e9 / imu.getSampleRate()));
+    if (realtime)
+        RealTime::configureThread(pthread_self(), "imu_reader", REALTIME_PRIORITY_IMU, RealTime::cpuForThread(0));
 
-    while(!done) {
-        // Read sensor data 
-        gettimeofday(&start_time, NULL);
-        imu.getMotion6(&ax, &ay, &az, &gx, &gy, &gz);
-        gettimeofday(&current_time, NULL);
-        // Write start and end times of measurement
-        fprintf(f,"%ld.%06ld,%ld.%06ld,",
-            (long int) start_time.tv_sec, (long int) start_time.tv_usec, 
-            (long int) current_time.tv_sec, (long int) current_time.tv_usec);
-        // Write acceleration data in g's
-        fprintf(f,"%0.6f,%0.6f,%0.6f,", (float) ax*accel_scaling, (float) ay*accel_scaling, (float) az*accel_scaling);
-        // Write gyro data in rad/s
-        fprintf(f,"%0.6f,%0.6f,%0.6f\n", (float) gx*gyro_scaling, (float) gy*gyro_scaling, (float) gz*gyro_scaling);
-        fflush(stdout);
-        bcm2835_delay(1);
+    if (dmp_firmware) {
+        // "-" leaves the image to dmpInitialize(), which looks it up in the environment
+        if (strcmp(dmp_firmware, "-") != 0 && !MPU6050::dmpLoadFirmware(dmp_firmware))
+            return 1;
+        uint8_t status = imu.dmpInitialize();
+        if (status != 0) {
+            fprintf(stderr, "MPU6050 DMP initialization failed (code %d)\n", status);
+            return 1;
+        }
+        printf("MPU6050 DMP firmware uploaded in %0.1f ms\n", imu.dmpGetUploadTime() / 1000.0);
+        log.setSamplePeriod((uint32_t) (1e9 / imu.dmpGetSampleFrequency()));
+        sample_clock.reset(log.getHeader()->samplePeriodNs);
+        imu.setDMPEnabled(true);
+        uint8_t packets[MPU6050_DMP_MAX_PACKETS * MPU6050_DMP_PACKET_SIZE];
+        int16_t quaternion[4];
+        bool overflow;
+        timer.start();
+        while(!done) {
+            // Timed like FIFO mode, one packet per DMP output period
+            uint16_t count = imu.dmpReadPackets(packets, MPU6050_DMP_MAX_PACKETS, &overflow);
+            current_time = BinaryLog::now();
+            if (overflow) {
+                log.writeGap(current_time, 0);
+                sample_clock.gap(current_time);
+            }
+            uint64_t first = sample_clock.update(current_time, count);
+            for (uint16_t i = 0; i < count; i++) {
+                imu.dmpGetQuaternion(quaternion, &packets[i * MPU6050_DMP_PACKET_SIZE]);
+                uint64_t sample_time = sample_clock.timestamp(first + i, current_time);
+                log.write(sample_time, current_time - sample_time, quaternion);
+            }
+            timer.wait();
+            print_requested_stats(timer);
+        }
+        imu.setDMPEnabled(false);
+    } else if (fifo_mode) {
+        sample_clock.reset(log.getHeader()->samplePeriodNs);
+        MPU6050Frame frames[MPU6050_FIFO_MAX_FRAMES];
+        bool overflow;
+        timer.start();
+        while(!done) {
+            // Drain every complete frame buffered since the last pass
+            uint16_t count = imu.readFIFOFrames(frames, MPU6050_FIFO_MAX_FRAMES, &overflow);
+            current_time = BinaryLog::now();
+            if (overflow) {
+                log.writeGap(current_time, 0);
+                sample_clock.gap(current_time);
+            }
+            // Each frame is stamped from the sensor clock fitted to the drain times,
+            // the latency then runs to the drain completion time
+            uint64_t first = sample_clock.update(current_time, count);
+            for (uint16_t i = 0; i < count; i++) {
+                uint64_t sample_time = sample_clock.timestamp(first + i, current_time);
+                log.write(sample_time, current_time - sample_time, &frames[i]);
+            }
+            timer.wait();
+            print_requested_stats(timer);
+        }
+        imu.endFIFOAcquisition();
+    } else if (irq_chip) {
+        // The profile pulses INT high for 50us on every new sample, so each sample is exactly one rising edge
+        GPIOLine irq;
+        if (!irq.request(irq_chip, irq_line, GPIO_EDGE_RISING))
+            return 1;
+        GPIOEdgeEvent event;
+        while(!done) {
+            int ret = irq.waitEvent(100, &event);
+            if (ret == 0 || (ret < 0 && errno == EINTR))
+                continue;
+            if (ret < 0) {
+                perror("GPIO event");
+                break;
+            }
+            irq_wakeup.add(PeriodicTimer::now() - event.timestamp_ns);
+            // Read exactly once per edge, the edge timestamp is the sample time.
+            // The kernel stamps CLOCK_MONOTONIC, the log runs on the raw clock
+            imu.getMotion6(&sample[0], &sample[1], &sample[2], &sample[3], &sample[4], &sample[5]);
+            current_time = BinaryLog::now();
+            uint64_t edge_time = TimeBase::fromMonotonic(event.timestamp_ns);
+            if (event.missed)
+                log.writeGap(edge_time, event.missed);
+            log.write(edge_time, current_time - edge_time, sample);
+            if (stats_requested) {
+                stats_requested = 0;
+                irq_wakeup.print(stdout, "MPU6050 interrupt wakeup");
+                I2CStats::print(stdout);
+                fflush(stdout);
+            }
+        }
+        imu.setIntEnabled(0);
+    } else if (redundant) {
+        timer.start();
+        while(!done) {
+            // Both sensors in one combined transfer, each stamped with the time its
+            // data started on the wire, so the pair is only a read apart
+            bool ok = batch.execute();
+            current_time = BinaryLog::now();
+            if (ok) {
+                imu.getBatchedMotion6(&sample[0], &sample[1], &sample[2], &sample[3], &sample[4], &sample[5]);
+                imu2.getBatchedMotion6(&sample2[0], &sample2[1], &sample2[2], &sample2[3], &sample2[4], &sample2[5]);
+                start_time = TimeBase::fromMonotonic(batch.getReadTime(0));
+                log.write(start_time, current_time - start_time, sample);
+                start_time = TimeBase::fromMonotonic(batch.getReadTime(1));
+                log2.write(start_time, current_time - start_time, sample2);
+            } else {
+                log.writeGap(current_time, 1);
+                log2.writeGap(current_time, 1);
+            }
+            uint32_t skipped = timer.wait();
+            if (skipped) {
+                log.writeGap(BinaryLog::now(), skipped);
+                log2.writeGap(BinaryLog::now(), skipped);
+            }
+            print_requested_stats(timer);
+        }
+    } else {
+        timer.start();
+        while(!done) {
+            // Read sensor data 
+            start_time = BinaryLog::now();
+            imu.getMotion6(&sample[0], &sample[1], &sample[2], &sample[3], &sample[4], &sample[5]);
+            current_time = BinaryLog::now();
+            // Log raw accel and gyro with start time and duration of the measurement
+            log.write(start_time, current_time - start_time, sample);
+            // Sleep until the next whole period, an overrun skips the samples it missed
+            uint32_t skipped = timer.wait();
+            if (skipped)
+                log.writeGap(BinaryLog::now(), skipped);
+            print_requested_stats(timer);
+        }
     }
     printf("Exiting cleanly...\n");
-    fclose(f);
+    log.close();
+    log.printStats(stdout);
+    if (redundant) {
+        log2.close();
+        log2.printStats(stdout);
+    }
+    if (irq_chip)
+        irq_wakeup.print(stdout, "MPU6050 interrupt wakeup");
+    else
+        timer.printStats(stdout, "MPU6050");
+    I2CStats::print(stdout);
+    if (fifo_mode || dmp_firmware)
+        sample_clock.printStats(stdout, dmp_firmware ? "MPU6050 DMP" : "MPU6050");
     return 0; 
 }
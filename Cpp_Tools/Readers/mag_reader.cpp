@@ -2,79 +2,131 @@
 #include <stdio.h>
 #include <signal.h>
 #include <time.h>
-#include <sys/time.h>
+#include <unistd.h>
+#include <pthread.h>
 
 // Libraries for I2C and the HMC6343 sensor
 #include <bcm2835.h>
 #include "HMC6343.h"
+#include "BinaryLog.h"
+#include "PeriodicTimer.h"
+#include "RealTime.h"
 
 #define PI 3.14159265359
 
+#define MAG_PERIOD_NS 200000000ull
+
 // Signal handler callback function
 volatile sig_atomic_t done = 0;
 void sig_handler(int signum) {
     done = 1;
 }
 
+// SIGUSR1 prints the loop and bus statistics while running
+volatile sig_atomic_t stats_requested = 0;
+void stats_handler(int signum) {
+    stats_requested = 1;
+}
+void usage(const char *name) {
+    fprintf(stderr, "Usage: %s [-r]\n"
+                    "  -r             real-time mode: lock memory, SCHED_FIFO on a core of its own\n",
+            name);
+}
+
+int main(int argc, char **argv) {
+    bool realtime = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "r")) != -1) {
+        switch (opt) {
+            case 'r': realtime = true; break;
+            default: usage(argv[0]); return 1;
+        }
+    }
 
-int main() {
     // Set up signal handler
     struct sigaction action;
     memset(&action, 0, sizeof(struct sigaction));
     action.sa_handler = sig_handler;
     sigaction(SIGTERM, &action, NULL);
     sigaction(SIGINT, &action, NULL);
+    action.sa_handler = stats_handler;
+    sigaction(SIGUSR1, &action, NULL);
 
     // Create new file with timestamp
     char filename_buffer[255];
     time_t t = time(NULL);
     struct tm tm = *localtime(&t);
-    sprintf(filename_buffer, "mag_data_%04d-%02d-%02dT%02d%02d%02d.log", 
+    sprintf(filename_buffer, "mag_data_%04d-%02d-%02dT%02d%02d%02d.bin", 
             tm.tm_year+1900, tm.tm_mon+1, tm.tm_mday, 
             tm.tm_hour, tm.tm_min, tm.tm_sec);
-    FILE *f = fopen(filename_buffer, "w");
+
+    // Real-time mode locks memory before the log buffers are allocated and
+    // leaves core 0 to the log writer thread
+    if (realtime) {
+        RealTime::lockMemory();
+        RealTime::pinThread(pthread_self(), 0);
+    }
+
+    // Raw readings go to a binary log with these scale factors in its header:
+    // yaw, pitch, roll in radians, accel xyz in g's, temperature as reported
+    const double scale[7] = { 1/10.0*PI/180.0, 1/10.0*PI/180.0, 1/10.0*PI/180.0,
+                              1/1024.0, 1/1024.0, 1/1024.0, 1.0 };
+    BinaryLog log;
+    if (!log.open(filename_buffer, BINLOG_DEVICE_HMC6343, 7, scale, 0, "HMC6343 sideways"))
+        return 1;
+    log.setSamplePeriod(MAG_PERIOD_NS);
 
     // Initialize I2C and the compass itself
     I2Cdev::initialize();
     HMC6343 compass;
-    if (!compass.init()) {
+    // Sideways orientation, run mode and the default 5Hz rate, only the settings that differ are sent
+    if (!compass.applyProfile(HMC6343_PROFILE_SIDEWAYS_5HZ)) {
       // Report failure, is the sensor wiring correct?
       printf("Sensor Initialization Failed\n");
     }
 
-    // Ensure orientation is selected, options are LEVEL, SIDEWAYS, and FLATFRONT (enumerated in HMC6343 header)
-    compass.setOrientation(SIDEWAYS);
-
-    // Initialize time
-    struct timeval start_time, current_time;
+    // Monotonic measurement times in ns
+    uint64_t start_time, current_time;
+    int16_t sample[7];
 
+    // One measurement per 200ms release, however long the reads take
+    PeriodicTimer timer(MAG_PERIOD_NS);
+    if (realtime)
+        RealTime::configureThread(pthread_self(), "mag_reader", REALTIME_PRIORITY_MAG, RealTime::cpuForThread(1));
+    timer.start();
     while(!done) {
         // Read compass data
-        gettimeofday(&start_time, NULL);
+        start_time = BinaryLog::now();
         compass.readTilt();
         compass.readHeading();
         compass.readAccel();
         compass.readMag();
-        gettimeofday(&current_time, NULL);
-        // Print start and end times of measurement
-        fprintf(f,"%ld.%06ld,%ld.%06ld,",
-            (long int) start_time.tv_sec, (long int) start_time.tv_usec, 
-            (long int) current_time.tv_sec, (long int) current_time.tv_usec);
-        // Print yaw, pitch, roll in radians
-        fprintf(f,"%0.6f,%0.6f,%0.6f,",
-                (float) compass.heading/10.0*PI/180.0, (float) compass.pitch/10.0*PI/180.0, (float) compass.roll/10.0*PI/180.0);
-        // Print accel xyz in g's
-        fprintf(f,"%0.6f,%0.6f,%0.6f,",
-                (float) compass.accelX/1024.0, (float) compass.accelY/1024.0, (float) compass.accelZ/1024.0);
-        // Print temperature in Celsius?
-        fprintf(f,"%0.4f\n", (float) compass.temperature);
-        fflush(f);
-        
-        // Wait for minimum time
-        bcm2835_delay(200);
+        current_time = BinaryLog::now();
+        // Log start time and duration of the measurement with the raw readings
+        sample[0] = compass.heading;
+        sample[1] = compass.pitch;
+        sample[2] = compass.roll;
+        sample[3] = compass.accelX;
+        sample[4] = compass.accelY;
+        sample[5] = compass.accelZ;
+        sample[6] = compass.temperature;
+        log.write(start_time, current_time - start_time, sample);
+
+        uint32_t skipped = timer.wait();
+        if (skipped)
+            log.writeGap(BinaryLog::now(), skipped);
+        if (stats_requested) {
+            stats_requested = 0;
+            timer.printStats(stdout, "HMC6343");
+            I2CStats::print(stdout);
+            fflush(stdout);
+        }
     }
     printf("Exiting cleanly...\n");
-    fclose(f);
+    log.close();
+    log.printStats(stdout);
+    timer.printStats(stdout, "HMC6343");
+    I2CStats::print(stdout);
     return 0;
 }
 
@@ -0,0 +1,79 @@
+// Routes SkyTraq payloads to per-message handlers
+
+#include "SkyTraqDispatcher.h"
+#include <string.h>
+
+static const SkyTraqLayout *const LAYOUTS[] = {
+    &SKYTRAQ_NAV_DATA_LAYOUT,
+    &SKYTRAQ_ACK_LAYOUT,
+    &SKYTRAQ_NACK_LAYOUT,
+    &SKYTRAQ_SOFTWARE_VERSION_LAYOUT,
+    &SKYTRAQ_SOFTWARE_CRC_LAYOUT,
+    &SKYTRAQ_POSITION_RATE_LAYOUT,
+    &SKYTRAQ_DATUM_LAYOUT,
+    &SKYTRAQ_DOP_MASK_LAYOUT,
+    &SKYTRAQ_ELEVATION_MASK_LAYOUT,
+};
+
+SkyTraqDispatcher::SkyTraqDispatcher() : unhandled(0), rejected(0) {
+  memset(table, 0, sizeof(table));
+}
+
+/** Get the wire layout of a known message.
+ * @return Layout, or NULL if the ID has no decoder
+ */
+const SkyTraqLayout *SkyTraqDispatcher::getLayout(uint8_t id) {
+  for (unsigned i = 0; i < sizeof(LAYOUTS) / sizeof(LAYOUTS[0]); i++) {
+    if (LAYOUTS[i]->id == id)
+      return LAYOUTS[i];
+  }
+  return NULL;
+}
+
+/** Register a handler for one message ID.
+ * @param handler Called with the decoded message, or NULL to ignore the ID again
+ * @param context Passed through to the handler
+ * @return False if there is no decoder for the ID
+ */
+bool SkyTraqDispatcher::setHandler(uint8_t id, SkyTraqHandler handler, void *context) {
+  const SkyTraqLayout *layout = getLayout(id);
+  if (layout == NULL)
+    return false;
+  table[id].layout = handler ? layout : NULL;
+  table[id].handler = handler;
+  table[id].context = context;
+  return true;
+}
+
+/** Register the same handler for every message that has a decoder.
+ */
+void SkyTraqDispatcher::setDefaultHandlers(SkyTraqHandler handler, void *context) {
+  for (unsigned i = 0; i < sizeof(LAYOUTS) / sizeof(LAYOUTS[0]); i++)
+    setHandler(LAYOUTS[i]->id, handler, context);
+}
+
+/** Decode a validated payload and pass it to its handler.
+ * Safe on arbitrary input: only the declared length is ever read.
+ * @param payload Message ID followed by the message body
+ * @param length Payload length
+ * @return SKYTRAQ_DISPATCH_OK, SKYTRAQ_DISPATCH_UNHANDLED or SKYTRAQ_DISPATCH_SHORT
+ */
+uint8_t SkyTraqDispatcher::dispatch(const uint8_t *payload, uint16_t length) {
+  if (length == 0) {
+    rejected++;
+    return SKYTRAQ_DISPATCH_SHORT;
+  }
+  const Entry *entry = &table[payload[0]];
+  if (entry->handler == NULL) {
+    unhandled++;
+    return SKYTRAQ_DISPATCH_UNHANDLED;
+  }
+  SkyTraqMessage message;
+  message.id = payload[0];
+  if (!skytraqDecode(entry->layout, payload, length, &message.nav)) {
+    rejected++;
+    return SKYTRAQ_DISPATCH_SHORT;
+  }
+  entry->handler(&message, entry->context);
+  return SKYTRAQ_DISPATCH_OK;
+}
@@ -0,0 +1,47 @@
+/* Routes SkyTraq payloads to per-message handlers
+   A 256-entry table indexed by message ID holds the layout and handler for
+   each registered message. Dispatching a payload costs one table lookup;
+   messages nobody registered for are dropped right after the ID byte,
+   without decoding anything.
+*/
+
+#ifndef _SKYTRAQDISPATCHER_H_
+#define _SKYTRAQDISPATCHER_H_
+
+#include <stdint.h>
+#include "SkyTraqMessages.h"
+
+// dispatch() results
+#define SKYTRAQ_DISPATCH_OK        0
+#define SKYTRAQ_DISPATCH_UNHANDLED 1   // no handler for this ID
+#define SKYTRAQ_DISPATCH_SHORT     2   // payload shorter than the message layout
+
+typedef void (*SkyTraqHandler)(const SkyTraqMessage *message, void *context);
+
+class SkyTraqDispatcher {
+ public:
+    SkyTraqDispatcher();
+
+    bool setHandler(uint8_t id, SkyTraqHandler handler, void *context=0);
+    void setDefaultHandlers(SkyTraqHandler handler, void *context=0);
+
+    uint8_t dispatch(const uint8_t *payload, uint16_t length);
+
+    static const SkyTraqLayout *getLayout(uint8_t id);
+
+    uint32_t getUnhandled() const { return unhandled; }
+    uint32_t getRejected() const { return rejected; }
+
+ private:
+    typedef struct entry {
+        const SkyTraqLayout *layout;
+        SkyTraqHandler handler;
+        void *context;
+    } Entry;
+
+    Entry table[256];
+    uint32_t unhandled;
+    uint32_t rejected;
+};
+
+#endif /* _SKYTRAQDISPATCHER_H_ */
@@ -0,0 +1,199 @@
+// SkyTraq binary protocol framing over a mirrored ring buffer
+
+#include "SkyTraqFramer.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+SkyTraqFramer::SkyTraqFramer() : ring(NULL), size(0), mask(0), head(0), tail(0) {
+  memset(&stats, 0, sizeof(stats));
+}
+
+SkyTraqFramer::~SkyTraqFramer() {
+  end();
+}
+
+/** Map the ring buffer.
+ * The same memfd pages are mapped at ring and at ring+size, so reads past the
+ * end of the ring land back at its start.
+ * @param size Ring size in bytes, a power of two and a multiple of the page size
+ * @return True on success
+ */
+bool SkyTraqFramer::begin(uint32_t size) {
+  end();
+  long page = sysconf(_SC_PAGESIZE);
+  if (size < 2 * (SKYTRAQ_MAX_PAYLOAD + SKYTRAQ_OVERHEAD) || (size & (size - 1)) || size % page) {
+    fprintf(stderr, "SkyTraqFramer: invalid ring size %u\n", size);
+    return false;
+  }
+
+  int fd = memfd_create("skytraq_ring", MFD_CLOEXEC);
+  if (fd < 0 || ftruncate(fd, size) < 0) {
+    perror("SkyTraqFramer: memfd");
+    if (fd >= 0)
+      close(fd);
+    return false;
+  }
+  // Reserve both halves first so the two fixed mappings cannot clobber anything
+  uint8_t *base = (uint8_t *) mmap(NULL, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED ||
+      mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+      mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+    perror("SkyTraqFramer: mmap");
+    if (base != MAP_FAILED)
+      munmap(base, 2 * size);
+    close(fd);
+    return false;
+  }
+  // The mappings keep the pages alive
+  close(fd);
+
+  ring = base;
+  this->size = size;
+  mask = size - 1;
+  reset();
+  return true;
+}
+
+void SkyTraqFramer::end() {
+  if (ring) {
+    munmap(ring, 2 * size);
+    ring = NULL;
+  }
+}
+
+/** Drop all buffered data and clear the statistics.
+ */
+void SkyTraqFramer::reset() {
+  head = tail = 0;
+  memset(&stats, 0, sizeof(stats));
+}
+
+/** Get contiguous free space for the producer.
+ * Thanks to the mirror mapping the whole free space is contiguous.
+ * @param space Number of bytes that may be written
+ * @return Where to write them
+ */
+uint8_t *SkyTraqFramer::writePointer(uint32_t *space) {
+  *space = size - (tail - head);
+  return ring + (tail & mask);
+}
+
+/** Make bytes written through writePointer() visible to next().
+ */
+void SkyTraqFramer::commit(uint32_t length) {
+  tail += length;
+}
+
+/** Read whatever a non-blocking descriptor has available straight into the ring.
+ * Frames returned by earlier next() calls may be overwritten.
+ * @param fd Serial port or any other byte stream
+ * @return Bytes read, 0 at end of file or when the ring is full, -1 with errno set
+ */
+ssize_t SkyTraqFramer::fill(int fd) {
+  uint32_t space;
+  uint8_t *dst = writePointer(&space);
+  if (space == 0) {
+    stats.overruns++;
+    return 0;
+  }
+  ssize_t n = read(fd, dst, space);
+  if (n > 0)
+    commit(n);
+  return n;
+}
+
+/** Copy bytes from memory into the ring, for recorded streams and tests.
+ * @return Number of bytes accepted
+ */
+uint32_t SkyTraqFramer::push(const uint8_t *data, uint32_t length) {
+  uint32_t space;
+  uint8_t *dst = writePointer(&space);
+  if (length > space) {
+    stats.overruns++;
+    length = space;
+  }
+  memcpy(dst, data, length);
+  commit(length);
+  return length;
+}
+
+/** XOR of all bytes, eight at a time.
+ */
+uint8_t SkyTraqFramer::checksum(const uint8_t *data, uint32_t length) {
+  uint64_t acc = 0;
+  uint32_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t word;
+    memcpy(&word, data + i, 8);
+    acc ^= word;
+  }
+  acc ^= acc >> 32;
+  acc ^= acc >> 16;
+  acc ^= acc >> 8;
+  uint8_t ret = (uint8_t) acc;
+  for (; i < length; i++)
+    ret ^= data[i];
+  return ret;
+}
+
+/** Find the next valid frame.
+ * The returned view stays valid until the next fill(), commit() or push().
+ * @param frame Filled with a view of the payload
+ * @return True if a frame was found, false if more data is needed
+ */
+bool SkyTraqFramer::next(SkyTraqFrame *frame) {
+  while (tail - head >= SKYTRAQ_OVERHEAD + 1) {
+    uint32_t avail = tail - head;
+    const uint8_t *p = ring + (head & mask);
+
+    // Skip to the next A0; memchr scans a word or vector at a time
+    if (p[0] != 0xA0 || p[1] != 0xA1) {
+      const uint8_t *sync = (const uint8_t *) memchr(p + 1, 0xA0, avail - 1);
+      while (sync && sync + 1 < p + avail && sync[1] != 0xA1)
+        sync = (const uint8_t *) memchr(sync + 1, 0xA0, p + avail - sync - 1);
+      if (sync == NULL) {
+        stats.discarded += avail;
+        head = tail;
+        return false;
+      }
+      stats.discarded += sync - p;
+      head += sync - p;
+      continue;
+    }
+
+    uint16_t length = (p[2] << 8) | p[3];
+    if (length == 0 || length > SKYTRAQ_MAX_PAYLOAD) {
+      stats.badFraming++;
+      stats.discarded++;
+      head++;
+      continue;
+    }
+    if (avail < (uint32_t) length + SKYTRAQ_OVERHEAD)
+      return false;
+
+    const uint8_t *payload = p + SKYTRAQ_HEADER_SIZE;
+    if (payload[length + 1] != 0x0D || payload[length + 2] != 0x0A) {
+      stats.badFraming++;
+      stats.discarded++;
+      head++;
+      continue;
+    }
+    if (checksum(payload, length) != payload[length]) {
+      stats.badChecksum++;
+      stats.discarded++;
+      head++;
+      continue;
+    }
+
+    frame->payload = payload;
+    frame->length = length;
+    frame->position = head;
+    head += length + SKYTRAQ_OVERHEAD;
+    stats.frames++;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,79 @@
+/* SkyTraq binary protocol framing over a mirrored ring buffer
+   Frames look like  A0 A1 | len (BE16) | payload[len] | xor(payload) | 0D 0A
+   where the first payload byte is the message ID.
+
+   Serial data is read straight into the ring (fill()), and complete frames
+   are handed out as pointers into it (next()), so nothing is copied between
+   the driver and the decoder. The ring is mapped twice back to back in
+   virtual memory, which means any run of up to `size` bytes starting inside
+   the ring is contiguous. A frame that wraps around the end of the ring is
+   therefore still one plain pointer and length.
+
+   Framing relies on the length field, not on the CR LF trailer, so binary
+   payloads that happen to contain 0D 0A or A0 A1 are handled correctly. A
+   candidate frame with a bad length, trailer or checksum only discards its
+   first byte, and the scan resumes from there.
+*/
+
+#ifndef _SKYTRAQFRAMER_H_
+#define _SKYTRAQFRAMER_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+
+// Default ring size, must be a power of two and a multiple of the page size
+#define SKYTRAQ_RING_SIZE 8192
+
+// Header (sync + length) plus trailer (checksum + CR LF)
+#define SKYTRAQ_HEADER_SIZE   4
+#define SKYTRAQ_OVERHEAD      7
+// Largest payload accepted; the Venus receivers never send more than a few hundred bytes
+#define SKYTRAQ_MAX_PAYLOAD   1024
+
+typedef struct skytraq_frame {
+    const uint8_t *payload; // message ID followed by the message body, points into the ring
+    uint16_t length;        // payload length including the message ID
+    uint32_t position;      // stream offset of the A0 sync byte (wraps at 4 GiB)
+} SkyTraqFrame;
+
+typedef struct skytraq_framer_stats {
+    uint32_t frames;        // frames delivered
+    uint32_t badChecksum;   // candidates rejected on the payload checksum
+    uint32_t badFraming;    // candidates rejected on length or CR LF trailer
+    uint32_t discarded;     // bytes skipped while looking for a sync sequence
+    uint32_t overruns;      // fill() calls that found the ring full
+} SkyTraqFramerStats;
+
+class SkyTraqFramer {
+ public:
+    SkyTraqFramer();
+    ~SkyTraqFramer();
+
+    bool begin(uint32_t size=SKYTRAQ_RING_SIZE);
+    void end();
+    void reset();
+
+    // Producer side
+    uint8_t *writePointer(uint32_t *space);
+    void commit(uint32_t length);
+    ssize_t fill(int fd);
+    uint32_t push(const uint8_t *data, uint32_t length);
+
+    // Consumer side
+    bool next(SkyTraqFrame *frame);
+
+    uint32_t getPosition() const { return tail; }
+    const SkyTraqFramerStats *getStats() const { return &stats; }
+
+    static uint8_t checksum(const uint8_t *data, uint32_t length);
+
+ private:
+    uint8_t *ring;
+    uint32_t size;
+    uint32_t mask;
+    uint32_t head;  // free-running offset of the first unconsumed byte
+    uint32_t tail;  // free-running offset one past the last received byte
+    SkyTraqFramerStats stats;
+};
+
+#endif /* _SKYTRAQFRAMER_H_ */
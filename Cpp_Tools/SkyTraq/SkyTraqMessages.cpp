@@ -0,0 +1,182 @@
+// SkyTraq binary output messages
+
+#include "SkyTraqMessages.h"
+
+/** Wire layouts. Offsets follow the field tables in AN0003, counted from
+ * the message ID. Every table must list its fields in wire order.
+ */
+static constexpr SkyTraqField NAV_DATA_FIELDS[] = {
+    SKYTRAQ_FIELD(SkyTraqNavData, fixMode,       1),
+    SKYTRAQ_FIELD(SkyTraqNavData, satellites,    2),
+    SKYTRAQ_FIELD(SkyTraqNavData, gpsWeek,       3),
+    SKYTRAQ_FIELD(SkyTraqNavData, timeOfWeek,    5),
+    SKYTRAQ_FIELD(SkyTraqNavData, latitude,      9),
+    SKYTRAQ_FIELD(SkyTraqNavData, longitude,    13),
+    SKYTRAQ_FIELD(SkyTraqNavData, ellipsoidAlt, 17),
+    SKYTRAQ_FIELD(SkyTraqNavData, seaLevelAlt,  21),
+    SKYTRAQ_FIELD(SkyTraqNavData, gdop,         25),
+    SKYTRAQ_FIELD(SkyTraqNavData, pdop,         27),
+    SKYTRAQ_FIELD(SkyTraqNavData, hdop,         29),
+    SKYTRAQ_FIELD(SkyTraqNavData, vdop,         31),
+    SKYTRAQ_FIELD(SkyTraqNavData, tdop,         33),
+    SKYTRAQ_FIELD(SkyTraqNavData, ecefX,        35),
+    SKYTRAQ_FIELD(SkyTraqNavData, ecefY,        39),
+    SKYTRAQ_FIELD(SkyTraqNavData, ecefZ,        43),
+    SKYTRAQ_FIELD(SkyTraqNavData, ecefVX,       47),
+    SKYTRAQ_FIELD(SkyTraqNavData, ecefVY,       51),
+    SKYTRAQ_FIELD(SkyTraqNavData, ecefVZ,       55),
+};
+
+static constexpr SkyTraqField ACK_FIELDS[] = {
+    SKYTRAQ_FIELD(SkyTraqAck, requestId, 1),
+};
+
+static constexpr SkyTraqField SOFTWARE_VERSION_FIELDS[] = {
+    SKYTRAQ_FIELD(SkyTraqSoftwareVersion, softwareType,   1),
+    SKYTRAQ_FIELD(SkyTraqSoftwareVersion, kernelVersion,  2),
+    SKYTRAQ_FIELD(SkyTraqSoftwareVersion, odmVersion,     6),
+    SKYTRAQ_FIELD(SkyTraqSoftwareVersion, revision,      10),
+};
+
+static constexpr SkyTraqField SOFTWARE_CRC_FIELDS[] = {
+    SKYTRAQ_FIELD(SkyTraqSoftwareCRC, softwareType, 1),
+    SKYTRAQ_FIELD(SkyTraqSoftwareCRC, crc,          2),
+};
+
+static constexpr SkyTraqField POSITION_RATE_FIELDS[] = {
+    SKYTRAQ_FIELD(SkyTraqPositionRate, rate, 1),
+};
+
+static constexpr SkyTraqField DATUM_FIELDS[] = {
+    SKYTRAQ_FIELD(SkyTraqDatum, index, 1),
+};
+
+static constexpr SkyTraqField DOP_MASK_FIELDS[] = {
+    SKYTRAQ_FIELD(SkyTraqDOPMask, mode, 1),
+    SKYTRAQ_FIELD(SkyTraqDOPMask, pdop, 2),
+    SKYTRAQ_FIELD(SkyTraqDOPMask, hdop, 4),
+    SKYTRAQ_FIELD(SkyTraqDOPMask, gdop, 6),
+};
+
+static constexpr SkyTraqField ELEVATION_MASK_FIELDS[] = {
+    SKYTRAQ_FIELD(SkyTraqElevationMask, mode,      1),
+    SKYTRAQ_FIELD(SkyTraqElevationMask, elevation, 2),
+    SKYTRAQ_FIELD(SkyTraqElevationMask, cnr,       3),
+};
+
+#define COUNT(fields) (sizeof(fields) / sizeof(fields[0]))
+#define LAYOUT(id, fields) { id, COUNT(fields), skytraqLayoutLength(fields, COUNT(fields)), fields }
+
+constexpr SkyTraqLayout SKYTRAQ_NAV_DATA_LAYOUT         = LAYOUT(SKYTRAQ_MSG_NAV_DATA, NAV_DATA_FIELDS);
+constexpr SkyTraqLayout SKYTRAQ_ACK_LAYOUT              = LAYOUT(SKYTRAQ_MSG_ACK, ACK_FIELDS);
+constexpr SkyTraqLayout SKYTRAQ_NACK_LAYOUT             = LAYOUT(SKYTRAQ_MSG_NACK, ACK_FIELDS);
+constexpr SkyTraqLayout SKYTRAQ_SOFTWARE_VERSION_LAYOUT = LAYOUT(SKYTRAQ_MSG_SOFTWARE_VERSION, SOFTWARE_VERSION_FIELDS);
+constexpr SkyTraqLayout SKYTRAQ_SOFTWARE_CRC_LAYOUT     = LAYOUT(SKYTRAQ_MSG_SOFTWARE_CRC, SOFTWARE_CRC_FIELDS);
+constexpr SkyTraqLayout SKYTRAQ_POSITION_RATE_LAYOUT    = LAYOUT(SKYTRAQ_MSG_POSITION_RATE, POSITION_RATE_FIELDS);
+constexpr SkyTraqLayout SKYTRAQ_DATUM_LAYOUT            = LAYOUT(SKYTRAQ_MSG_DATUM, DATUM_FIELDS);
+constexpr SkyTraqLayout SKYTRAQ_DOP_MASK_LAYOUT         = LAYOUT(SKYTRAQ_MSG_DOP_MASK, DOP_MASK_FIELDS);
+constexpr SkyTraqLayout SKYTRAQ_ELEVATION_MASK_LAYOUT   = LAYOUT(SKYTRAQ_MSG_ELEVATION_MASK, ELEVATION_MASK_FIELDS);
+
+// Catch typos in the tables against the lengths given in AN0003
+static_assert(skytraqLayoutLength(NAV_DATA_FIELDS, COUNT(NAV_DATA_FIELDS)) == 59, "navigation data is 59 bytes");
+static_assert(skytraqLayoutLength(SOFTWARE_VERSION_FIELDS, COUNT(SOFTWARE_VERSION_FIELDS)) == 14, "software version is 14 bytes");
+static_assert(skytraqLayoutLength(SOFTWARE_CRC_FIELDS, COUNT(SOFTWARE_CRC_FIELDS)) == 4, "software CRC is 4 bytes");
+static_assert(skytraqLayoutLength(DOP_MASK_FIELDS, COUNT(DOP_MASK_FIELDS)) == 8, "DOP mask is 8 bytes");
+
+/** Decode a payload into the struct described by a layout.
+ * The message ID is not checked, that is the caller's routing decision.
+ * @param layout Field table of the message
+ * @param payload Message ID followed by the message body
+ * @param length Payload length; trailing bytes beyond the layout are ignored
+ * @param out Struct matching the layout
+ * @return False if the payload is too short to hold every field
+ */
+bool skytraqDecode(const SkyTraqLayout *layout, const uint8_t *payload, uint16_t length, void *out) {
+  if (length < layout->minLength)
+    return false;
+  uint8_t *base = (uint8_t *) out;
+  for (uint8_t i = 0; i < layout->count; i++) {
+    const SkyTraqField *field = &layout->fields[i];
+    const uint8_t *src = payload + field->offset;
+    switch (field->size) {
+      case 1:
+        base[field->member] = src[0];
+        break;
+      case 2:
+        *(uint16_t *) (base + field->member) = (uint16_t) (src[0] << 8 | src[1]);
+        break;
+      case 4:
+        *(uint32_t *) (base + field->member) =
+            (uint32_t) src[0] << 24 | (uint32_t) src[1] << 16 | (uint32_t) src[2] << 8 | src[3];
+        break;
+    }
+  }
+  return true;
+}
+
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqNavData *out) {
+  return skytraqDecode(&SKYTRAQ_NAV_DATA_LAYOUT, payload, length, out);
+}
+
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqAck *out) {
+  return skytraqDecode(&SKYTRAQ_ACK_LAYOUT, payload, length, out);
+}
+
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqSoftwareVersion *out) {
+  return skytraqDecode(&SKYTRAQ_SOFTWARE_VERSION_LAYOUT, payload, length, out);
+}
+
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqSoftwareCRC *out) {
+  return skytraqDecode(&SKYTRAQ_SOFTWARE_CRC_LAYOUT, payload, length, out);
+}
+
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqPositionRate *out) {
+  return skytraqDecode(&SKYTRAQ_POSITION_RATE_LAYOUT, payload, length, out);
+}
+
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqDatum *out) {
+  return skytraqDecode(&SKYTRAQ_DATUM_LAYOUT, payload, length, out);
+}
+
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqDOPMask *out) {
+  return skytraqDecode(&SKYTRAQ_DOP_MASK_LAYOUT, payload, length, out);
+}
+
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqElevationMask *out) {
+  return skytraqDecode(&SKYTRAQ_ELEVATION_MASK_LAYOUT, payload, length, out);
+}
+
+/** Print a one-line human readable summary of a command reply.
+ * Navigation data is left to the caller, which usually logs it instead.
+ */
+void skytraqPrintMessage(FILE *out, const SkyTraqMessage *msg) {
+  switch (msg->id) {
+    case SKYTRAQ_MSG_ACK:
+      fprintf(out, "ACK for message 0x%02X\n", msg->ack.requestId);
+      break;
+    case SKYTRAQ_MSG_NACK:
+      fprintf(out, "NACK for message 0x%02X\n", msg->ack.requestId);
+      break;
+    case SKYTRAQ_MSG_SOFTWARE_VERSION:
+      fprintf(out, "Software version: kernel %06X, ODM %06X, revision %06X\n",
+              msg->version.kernelVersion, msg->version.odmVersion, msg->version.revision);
+      break;
+    case SKYTRAQ_MSG_SOFTWARE_CRC:
+      fprintf(out, "Software CRC: 0x%04X\n", msg->crc.crc);
+      break;
+    case SKYTRAQ_MSG_POSITION_RATE:
+      fprintf(out, "Position update rate: %d Hz\n", msg->rate.rate);
+      break;
+    case SKYTRAQ_MSG_DATUM:
+      fprintf(out, "Datum index: %d\n", msg->datum.index);
+      break;
+    case SKYTRAQ_MSG_DOP_MASK:
+      fprintf(out, "DOP mask: mode %d, PDOP %0.1f, HDOP %0.1f, GDOP %0.1f\n", msg->dopMask.mode,
+              msg->dopMask.pdop / 10.0, msg->dopMask.hdop / 10.0, msg->dopMask.gdop / 10.0);
+      break;
+    case SKYTRAQ_MSG_ELEVATION_MASK:
+      fprintf(out, "Elevation mask: mode %d, elevation %d deg, CNR %d dB-Hz\n",
+              msg->elevationMask.mode, msg->elevationMask.elevation, msg->elevationMask.cnr);
+      break;
+  }
+}
@@ -0,0 +1,159 @@
+/* SkyTraq binary output messages
+   Based on the SkyTraq Venus 6 GPS Receiver Binary Messages document (AN0003)
+   https://www.sparkfun.com/datasheets/GPS/Modules/AN0003_v1.4.14_FlashOnly.pdf
+
+   Each message is a plain struct whose members have exactly the width of
+   the corresponding big-endian wire field, described by a constant table of
+   (wire offset, member) pairs. One generic decoder walks that table, so a
+   new message only needs a struct and a field list. The minimum payload
+   length of every message is derived from its table at compile time, and a
+   payload shorter than that is rejected before any field is touched.
+
+   Payload offsets count from the message ID, which is byte 0. Values are
+   left in the receiver's units; see the comments for scaling.
+*/
+
+#ifndef _SKYTRAQMESSAGES_H_
+#define _SKYTRAQMESSAGES_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Output message IDs
+#define SKYTRAQ_MSG_SOFTWARE_VERSION 0x80
+#define SKYTRAQ_MSG_SOFTWARE_CRC     0x81
+#define SKYTRAQ_MSG_ACK              0x83
+#define SKYTRAQ_MSG_NACK             0x84
+#define SKYTRAQ_MSG_POSITION_RATE    0x86
+#define SKYTRAQ_MSG_NAV_DATA         0xA8
+#define SKYTRAQ_MSG_DATUM            0xAE
+#define SKYTRAQ_MSG_DOP_MASK         0xAF
+#define SKYTRAQ_MSG_ELEVATION_MASK   0xB0
+
+typedef struct skytraq_nav_data {
+    uint8_t fixMode;        // 0 no fix, 1 2D, 2 3D, 3 3D+DGPS
+    uint8_t satellites;     // satellites in the fix
+    uint16_t gpsWeek;
+    uint32_t timeOfWeek;    // 0.01 s
+    int32_t latitude;       // 1e-7 deg
+    int32_t longitude;      // 1e-7 deg
+    uint32_t ellipsoidAlt;  // 0.01 m
+    uint32_t seaLevelAlt;   // 0.01 m
+    uint16_t gdop;          // 0.01
+    uint16_t pdop;
+    uint16_t hdop;
+    uint16_t vdop;
+    uint16_t tdop;
+    int32_t ecefX;          // 0.01 m
+    int32_t ecefY;
+    int32_t ecefZ;
+    int32_t ecefVX;         // 0.01 m/s
+    int32_t ecefVY;
+    int32_t ecefVZ;
+} SkyTraqNavData;
+
+typedef struct skytraq_ack {
+    uint8_t requestId;      // ID of the acknowledged (or rejected) input message
+} SkyTraqAck;
+
+typedef struct skytraq_software_version {
+    uint8_t softwareType;   // 1 = system code
+    uint32_t kernelVersion; // 0x00XXYYZZ = X.Y.Z
+    uint32_t odmVersion;
+    uint32_t revision;      // 0x00YYMMDD
+} SkyTraqSoftwareVersion;
+
+typedef struct skytraq_software_crc {
+    uint8_t softwareType;
+    uint16_t crc;
+} SkyTraqSoftwareCRC;
+
+typedef struct skytraq_position_rate {
+    uint8_t rate;           // Hz
+} SkyTraqPositionRate;
+
+typedef struct skytraq_datum {
+    uint16_t index;         // datum table index, 0 = WGS-84
+} SkyTraqDatum;
+
+typedef struct skytraq_dop_mask {
+    uint8_t mode;           // 0 disabled, 1 auto, 2 PDOP, 3 HDOP, 4 GDOP
+    uint16_t pdop;          // 0.1
+    uint16_t hdop;
+    uint16_t gdop;
+} SkyTraqDOPMask;
+
+typedef struct skytraq_elevation_mask {
+    uint8_t mode;           // 0 disabled, 1 elevation and CNR, 2 elevation, 3 CNR
+    uint8_t elevation;      // deg
+    uint8_t cnr;            // dB-Hz
+} SkyTraqElevationMask;
+
+typedef struct skytraq_message {
+    uint8_t id;
+    union {
+        SkyTraqNavData nav;
+        SkyTraqAck ack;
+        SkyTraqSoftwareVersion version;
+        SkyTraqSoftwareCRC crc;
+        SkyTraqPositionRate rate;
+        SkyTraqDatum datum;
+        SkyTraqDOPMask dopMask;
+        SkyTraqElevationMask elevationMask;
+    };
+} SkyTraqMessage;
+
+/** One big-endian wire field stored into a struct member of the same width.
+ */
+typedef struct skytraq_field {
+    uint8_t offset;   // payload offset, the message ID is byte 0
+    uint8_t size;     // 1, 2 or 4 bytes
+    uint8_t member;   // offsetof the destination member
+} SkyTraqField;
+
+typedef struct skytraq_layout {
+    uint8_t id;
+    uint8_t count;
+    uint16_t minLength;
+    const SkyTraqField *fields;
+} SkyTraqLayout;
+
+#define SKYTRAQ_FIELD(type, member, offset) \
+    { offset, sizeof(((type *) 0)->member), offsetof(type, member) }
+
+/** Smallest payload that holds every field of a layout.
+ */
+constexpr uint16_t skytraqLayoutLength(const SkyTraqField *fields, uint8_t count) {
+    uint16_t length = 1;
+    for (uint8_t i = 0; i < count; i++) {
+        if (fields[i].offset + fields[i].size > length)
+            length = fields[i].offset + fields[i].size;
+    }
+    return length;
+}
+
+extern const SkyTraqLayout SKYTRAQ_NAV_DATA_LAYOUT;
+extern const SkyTraqLayout SKYTRAQ_ACK_LAYOUT;
+extern const SkyTraqLayout SKYTRAQ_NACK_LAYOUT;
+extern const SkyTraqLayout SKYTRAQ_SOFTWARE_VERSION_LAYOUT;
+extern const SkyTraqLayout SKYTRAQ_SOFTWARE_CRC_LAYOUT;
+extern const SkyTraqLayout SKYTRAQ_POSITION_RATE_LAYOUT;
+extern const SkyTraqLayout SKYTRAQ_DATUM_LAYOUT;
+extern const SkyTraqLayout SKYTRAQ_DOP_MASK_LAYOUT;
+extern const SkyTraqLayout SKYTRAQ_ELEVATION_MASK_LAYOUT;
+
+bool skytraqDecode(const SkyTraqLayout *layout, const uint8_t *payload, uint16_t length, void *out);
+
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqNavData *out);
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqAck *out);
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqSoftwareVersion *out);
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqSoftwareCRC *out);
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqPositionRate *out);
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqDatum *out);
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqDOPMask *out);
+bool skytraqDecode(const uint8_t *payload, uint16_t length, SkyTraqElevationMask *out);
+
+void skytraqPrintMessage(FILE *out, const SkyTraqMessage *message);
+
+#endif /* _SKYTRAQMESSAGES_H_ */
@@ -0,0 +1,115 @@
+// SkyTraq receiver on a serial port
+
+#include "SkyTraqSerial.h"
+#include "TimeBase.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+SkyTraqSerial::SkyTraqSerial() : fd(-1), rxNewest(0) {
+  memset(rxEnd, 0, sizeof(rxEnd));
+  memset(rxTime, 0, sizeof(rxTime));
+}
+
+SkyTraqSerial::~SkyTraqSerial() {
+  close();
+}
+
+/** Open and configure the serial port.
+ * @param device Serial device path
+ * @return True on success
+ */
+bool SkyTraqSerial::open(const char *device) {
+  close();
+  if (!framer.begin())
+    return false;
+
+  fd = ::open(device, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    printf("Could not open serial port %s\n", device);
+    return false;
+  }
+
+  // Raw 8N1 at 115200. VMIN=1/VTIME=0 makes the port readable as soon as any
+  // byte arrives, and epoll then lets the caller pick up whole driver buffers at once
+  struct termios tio;
+  memset(&tio, 0, sizeof(tio));
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, B115200);
+  cfsetospeed(&tio, B115200);
+  tio.c_cflag = tio.c_cflag & ~CSTOPB & ~PARENB & ~CRTSCTS;
+  tio.c_iflag = IGNPAR;
+  tio.c_cflag = tio.c_cflag | CLOCAL | CREAD;
+  tio.c_cc[VMIN] = 1;
+  tio.c_cc[VTIME] = 0;
+
+  if (tcsetattr(fd, TCSANOW, &tio) < 0) {
+    printf("Can't set terminal parameters\n");
+    close();
+    return false;
+  }
+
+  // Ask USB serial adapters to hand over data immediately rather than after
+  // their latency timer. Ptys and plain UARTs do not support this, which is fine.
+  struct serial_struct serial;
+  if (ioctl(fd, TIOCGSERIAL, &serial) == 0) {
+    serial.flags |= ASYNC_LOW_LATENCY;
+    ioctl(fd, TIOCSSERIAL, &serial);
+  }
+
+  /* clean I & O device */
+  tcflush(fd, TCIOFLUSH);
+  rxNewest = 0;
+  memset(rxEnd, 0, sizeof(rxEnd));
+  memset(rxTime, 0, sizeof(rxTime));
+  return true;
+}
+
+void SkyTraqSerial::close() {
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+/** Read whatever the port has buffered into the framer.
+ * @return Bytes read, 0 at end of file, -1 with errno set (EAGAIN when drained)
+ */
+ssize_t SkyTraqSerial::receive() {
+  ssize_t size = framer.fill(fd);
+  if (size > 0) {
+    rxNewest = (rxNewest + 1) % SKYTRAQ_RX_HISTORY;
+    rxEnd[rxNewest] = framer.getPosition();
+    rxTime[rxNewest] = TimeBase::now();
+  }
+  return size;
+}
+
+/** Take the next complete frame.
+ * @param frame View of the payload, valid until the next receive()
+ * @param startTime Arrival time of the read that delivered the sync bytes
+ * @param endTime Arrival time of the read that delivered the trailer
+ * @return False when no complete frame is buffered
+ */
+bool SkyTraqSerial::next(SkyTraqFrame *frame, uint64_t *startTime, uint64_t *endTime) {
+  if (!framer.next(frame))
+    return false;
+  *startTime = arrivalTime(frame->position);
+  *endTime = arrivalTime(frame->position + frame->length + SKYTRAQ_OVERHEAD - 1);
+  return true;
+}
+
+// Time of the oldest remembered read that delivered the byte at a stream position
+uint64_t SkyTraqSerial::arrivalTime(uint32_t position) const {
+  for (int k = 1; k <= SKYTRAQ_RX_HISTORY; k++) {
+    int i = (rxNewest + k) % SKYTRAQ_RX_HISTORY;
+    if ((int32_t) (rxEnd[i] - position) > 0)
+      return rxTime[i];
+  }
+  return rxTime[rxNewest];
+}
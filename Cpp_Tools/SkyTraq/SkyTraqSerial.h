@@ -0,0 +1,50 @@
+/* SkyTraq receiver on a serial port
+   Opens and configures the port (raw 8N1, 115200 baud) and feeds whatever
+   it delivers into a SkyTraqFramer. Every read is remembered with its
+   arrival time on the log time base (TimeBase.h), so each frame can be
+   stamped with the reads that delivered its first and last bytes.
+
+   The port is non-blocking; callers wait on getFD() with poll or epoll,
+   call receive() when it is readable, and then take frames with next()
+   until it returns false. Frames are only valid until the next receive().
+   Any tty works, including the slave side of a pty for testing.
+*/
+
+#ifndef _SKYTRAQSERIAL_H_
+#define _SKYTRAQSERIAL_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+#include "SkyTraqFramer.h"
+
+#define SKYTRAQ_DEFAULT_DEVICE "/dev/ttyUSB0"
+// Number of recent reads remembered for timestamping frames
+#define SKYTRAQ_RX_HISTORY 16
+
+class SkyTraqSerial {
+ public:
+    SkyTraqSerial();
+    ~SkyTraqSerial();
+
+    bool open(const char *device=SKYTRAQ_DEFAULT_DEVICE);
+    void close();
+    int getFD() const { return fd; }
+
+    ssize_t receive();
+    bool next(SkyTraqFrame *frame, uint64_t *startTime, uint64_t *endTime);
+
+    const SkyTraqFramerStats *getStats() const { return framer.getStats(); }
+
+ private:
+    int fd;
+    SkyTraqFramer framer;
+
+    // Stream position and arrival time of the most recent reads
+    uint32_t rxEnd[SKYTRAQ_RX_HISTORY];
+    uint64_t rxTime[SKYTRAQ_RX_HISTORY];
+    int rxNewest;
+
+    uint64_t arrivalTime(uint32_t position) const;
+};
+
+#endif /* _SKYTRAQSERIAL_H_ */